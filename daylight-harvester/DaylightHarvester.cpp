@@ -0,0 +1,175 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "PowerDevice.h"
+
+#include "pico/stdlib.h"
+#include "pico/time.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "AfDS3231PrecisionRtcDevice.h"
+#include "ControlConfiguration.h"
+#include "DaylightController.h"
+#include "EventLog.h"
+#include "FlashRegion.h"
+#include "LightSensor.h"
+#include "PwmPowerDevice.h"
+#include "Rp2040RtcCacheDevice.h"
+#include "ScheduleCalendar.h"
+#include "SerialBus.h"
+#include "SolarCalculator.h"
+#include "TimeScheduler.h"
+
+// The time between lux readings and control updates.
+constexpr uint32_t control_period_ms = 1000;
+// Readings are limited to 200 ms of integration, so one fits in a control period.
+constexpr auto maximum_integration_time = LightMeter::AlsConfigRegister::ms_200;
+// A status line is written, and the lux logged, every this many control periods.
+constexpr uint32_t status_period_count = 60;
+// The event log is kept in the sectors at the end of flash. At a reading a minute a page
+// fills and is programmed every sixteen minutes, the most lost at a power loss.
+constexpr uint32_t event_log_sector_count = 16;
+constexpr uint32_t event_log_offset 
+  = PICO_FLASH_SIZE_BYTES - event_log_sector_count * Core::FlashRegion::sector_size;
+// The lamp's PWM output.
+constexpr unsigned int lamp_gpio = 10;
+// The controller's location and the RTC's offset from UTC, for sunrise and sunset. The 
+// RTC is kept in local standard time.
+constexpr float latitude = 37.77f;
+constexpr float longitude = -122.42f;
+constexpr int16_t utc_offset_minutes = -8 * 60;
+
+int main() {
+
+  //
+  // Setup
+  //
+  stdio_init_all();
+  
+  // The light sensor shares the bus with the RTC.
+  Core::SerialBus serialBus;
+  gpio_pull_up(PICO_DEFAULT_I2C_SDA_PIN);
+  gpio_pull_up(PICO_DEFAULT_I2C_SCL_PIN);
+  
+  Device::AfDS3231PrecisionRtcDevice timeDevice(serialBus); 
+  timeDevice.init();
+  // The scheduler reads the time each second, from the on-chip RTC kept in step with the
+  // DS3231 rather than over the bus. Its hourly sync is polled while waiting on the light
+  // sensor and the next reading, so it does not hold up the control loop.
+  Device::Rp2040RtcCacheDevice clockDevice(timeDevice);
+  clockDevice.init();
+  
+  LightMeter::LightSensor lightSensor;
+  lightSensor.setMaximumIntegrationTime(maximum_integration_time);
+  lightSensor.init();
+  
+  Device::PwmPowerDevice lampDevice(lamp_gpio);
+  lampDevice.init();
+  
+  Core::DaylightController controller(lampDevice);
+  Core::DaylightController::Tuning tuning;
+  tuning.targetLux = 500.0f;
+  tuning.lampLux = 500.0f;
+  controller.setTuning(tuning);
+  
+  // Hold the target through the working day, fading the lamp out over a minute at the end.
+  Core::ControlConfiguration configuration;
+  configuration.transitionDuration = 60 * 1000;
+  Core::SolarCalculator solarCalculator(latitude, longitude, utc_offset_minutes);
+  Core::ScheduleCalendar calendar;
+  calendar.setSolarCalculator(solarCalculator);
+  Core::ScheduleRule workday;
+  workday.daysOfWeek = Core::ScheduleRule::weekdays;
+  workday.startTime = {0, 0, 7};
+  workday.endTime = {0, 0, 19};
+  calendar.addRule(workday);
+  
+  // The scheduler switches the controller, which switches the lamp.
+  Core::TimeScheduler scheduler(controller, clockDevice, configuration);
+  scheduler.setCalendar(calendar);
+  
+  Core::FlashRegion eventLogRegion(event_log_offset, event_log_sector_count);
+  Core::EventLog eventLog(eventLogRegion);
+  eventLog.init();
+  
+  auto lastReadingTime = get_absolute_time();
+  auto nextReadingTime = make_timeout_time_ms(control_period_ms);
+  uint32_t updateCount = 0;
+  lightSensor.start();
+  
+loop:
+  lightSensor.poll();
+  if (lightSensor.ready()) {
+    auto readingTime = get_absolute_time();
+    auto seconds = absolute_time_diff_us(lastReadingTime, readingTime) / 1.0e6f;
+    lastReadingTime = readingTime;
+    
+    auto status = controller.getStatus();
+    scheduler.update();
+    auto lux = lightSensor.getAmbientLightLux();
+    controller.update(lux, seconds);
+    
+    bool statusPeriod = ++updateCount % status_period_count == 0;
+    if (statusPeriod || controller.getStatus() != status) {
+      Core::EventRecord record = {};
+      record.clockDatum = clockDevice.read();
+      record.type = statusPeriod ? Core::EventRecord::sensorReading 
+                                 : Core::EventRecord::powerChange;
+      record.lux = static_cast<uint32_t>(std::clamp(lux * 1000.0f, 0.0f, 4.0e9f));
+      record.powerState = controller.getStatus();
+      eventLog.append(record);
+    }
+    if (statusPeriod) {
+      printf("lux %.1f, level %.3f, energy %.1f%%, switches %lu\n", lux, controller.getOutput(),
+             controller.getEnergyFraction() * 100.0f, controller.getSwitchCount());
+      printf("clock drift %.2f ppm, reads %lu local, %lu over I2C\n", clockDevice.getDriftPpm(),
+             clockDevice.getLocalReadCount(), clockDevice.getReferenceReadCount());
+    }
+    
+    while (!time_reached(nextReadingTime)) {
+      clockDevice.poll();
+      sleep_ms(1);
+    }
+    nextReadingTime = delayed_by_ms(nextReadingTime, control_period_ms);
+    lightSensor.start();
+  } else {
+    clockDevice.poll();
+    sleep_ms(1);
+  }
+  goto loop;
+  
+  return 0;
+}
@@ -0,0 +1,70 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#pragma once
+
+#include "Clock.h"
+
+namespace Core {
+
+///
+/// \brief Abstract base class for clock devices with an alarm.
+/// \description Defines an interface for devices that signal an interrupt line at a time
+///   of day, so a controller can sleep until then without keeping time itself.
+///
+class AlarmClockDevice {
+public:
+  AlarmClockDevice() = default;
+  AlarmClockDevice(const AlarmClockDevice&) = delete;
+  ~AlarmClockDevice() = default;
+  
+  ///
+  /// \brief Abstract method to set a daily alarm and enable its interrupt.
+  ///
+  /// \param time The time of day for the alarm.
+  ///
+  virtual void armAlarm(Time time) = 0;
+  ///
+  /// \brief Abstract method to disable the alarm's interrupt.
+  ///
+  virtual void disarmAlarm() = 0;
+  ///
+  /// \brief Abstract method to clear a triggered alarm, releasing the interrupt line.
+  ///
+  /// \return True if the alarm had triggered.
+  ///
+  virtual bool clearAlarm() = 0;
+}; // class AlarmClockDevice
+
+}; // namespace Core
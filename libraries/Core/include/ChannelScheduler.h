@@ -0,0 +1,113 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#pragma once
+
+#include "ControlConfiguration.h"
+#include "PowerDevice.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Core {
+  class RealTimeClockDevice;
+  
+  ///
+  /// \brief Schedules many power devices from one clock read per update.
+  /// \description Each channel is a power device with its own configuration, and several
+  ///   channels can share a configuration. The channels are kept as a structure of arrays,
+  ///   so an update scans just the span and revision arrays, and a channel is only
+  ///   searched again when the time leaves its span or its configuration changes. Each
+  ///   distinct configuration's revision is read once per update into an array, which 
+  ///   the channels index rather than following their configuration's pointer. Devices
+  ///   are only set when their state changes, and the changes of an update are listed.
+  ///   With room for 512 channels a scheduler takes about 18 KB, so it is best kept out 
+  ///   of the stack.
+  ///
+  class ChannelScheduler final {
+    public:
+      static constexpr size_t maximum_channels = 512;
+      static constexpr size_t maximum_configurations = maximum_channels;
+      
+      struct Change {
+        uint16_t channel;
+        PowerDevice::State state;
+      }; // struct Change
+      
+      ChannelScheduler() = delete;
+      ChannelScheduler(RealTimeClockDevice&);
+      
+      ///
+      /// \brief Add a channel, returning false when there is no room for it.
+      /// \description The configuration is kept by reference, and must outlive the
+      ///   scheduler.
+      ///
+      bool addChannel(PowerDevice&, const ControlConfiguration&);
+      size_t getChannelCount() const { return channelCount; }
+      size_t getConfigurationCount() const { return configurationCount; }
+      
+      ///
+      /// \brief Read the clock and switch the channels to their scheduled states.
+      /// \return The number of channels that changed state.
+      ///
+      size_t update();
+      const Change* getChanges() const { return &changes[0]; }
+      
+      ///
+      /// \brief Seconds from the last update to the next transition of any channel.
+      ///
+      uint32_t getSecondsToNextTransition() const { return nextTransition - currentSecond; }
+      
+    private:
+      RealTimeClockDevice& timeDevice;
+      size_t channelCount = 0;
+      size_t configurationCount = 0;
+      uint32_t currentSecond = 0;
+      uint32_t nextTransition = 0;
+      
+      const ControlConfiguration* configurations[maximum_configurations];
+      /// \brief Each configuration's revision as of the current update.
+      uint32_t configurationRevisions[maximum_configurations];
+      
+      PowerDevice* devices[maximum_channels];
+      uint16_t configurationIndexes[maximum_channels];
+      uint32_t spanStarts[maximum_channels];
+      uint32_t spanEnds[maximum_channels];
+      /// \brief The revision of its configuration each channel's span was found in.
+      uint32_t revisions[maximum_channels];
+      bool states[maximum_channels];
+      
+      Change changes[maximum_channels];
+  }; // class ChannelScheduler
+}; // namespace Core
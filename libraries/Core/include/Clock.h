@@ -35,12 +35,18 @@
 #pragma once
 
 #include <cstdint>
-#include <ctime>
 #include <compare>
 
 namespace Core {
 
+  ///
+  /// \brief A time of day.
+  /// \description Arithmetic is on the integer seconds of the day, and times compare field
+  ///   by field, so neither needs floating point or a multiply to compare.
+  ///
   struct Time final {
+    static constexpr uint32_t seconds_per_day = 24 * 60 * 60;
+    
     /// \brief Seconds for the time in the range of 0...59.
     uint8_t seconds;
     /// \brief Minutes for the time in the range of 0...59.
@@ -48,38 +54,185 @@ namespace Core {
     /// \brief The hour in a day for the time in the range 0...23. 
     uint8_t hour;
     
-    uint32_t inSeconds() const {
-      return ((static_cast<uint32_t>(hour) * 60.0) + static_cast<uint32_t>(minutes)) * 60.0 
-        + static_cast<uint32_t>(seconds);
+    constexpr uint32_t inSeconds() const {
+      return (static_cast<uint32_t>(hour) * 60 + minutes) * 60 + seconds;
+    }
+    
+    ///
+    /// \brief Whether each field is in range, so the time is a second of the day.
+    ///
+    constexpr bool isValid() const { return seconds < 60 && minutes < 60 && hour < 24; }
+    
+    ///
+    /// \brief The time at a second of the day, wrapping into the day.
+    ///
+    static constexpr Time fromSeconds(uint32_t secondOfDay) {
+      secondOfDay %= seconds_per_day;
+      return {
+        static_cast<uint8_t>(secondOfDay % 60),
+        static_cast<uint8_t>(secondOfDay / 60 % 60),
+        static_cast<uint8_t>(secondOfDay / 3600)
+      };
     }
     
-    friend auto operator<=>(const Time& time, const Time& other) {
-      return time.inSeconds() <=> other.inSeconds();
+    friend constexpr std::strong_ordering operator<=>(const Time& time, const Time& other) {
+      if (auto order = time.hour <=> other.hour; order != 0) {
+        return order;
+      }
+      if (auto order = time.minutes <=> other.minutes; order != 0) {
+        return order;
+      }
+      return time.seconds <=> other.seconds;
     }
+    
+    friend constexpr bool operator==(const Time& time, const Time& other) = default;
   }; // struct Time
   
+  static_assert(Time{59, 59, 23}.inSeconds() == Time::seconds_per_day - 1);
+  static_assert(Time::fromSeconds(Time{5, 4, 3}.inSeconds()) == Time{5, 4, 3});
+  static_assert(Time{0, 0, 12} > Time{59, 59, 11});
+  
+  ///
+  /// \brief Days from 2000-01-01 to a date in the proleptic Gregorian calendar.
+  /// \description Howard Hinnant's days_from_civil, counting from March so the leap day
+  ///   ends the year, and in 400 year eras, so it takes no loops or tables and one 
+  ///   comparison. For years from 2000.
+  ///
+  constexpr int32_t daysFromCivil(int32_t year, uint32_t month, uint32_t dayOfMonth) {
+    year -= month <= 2;
+    int32_t era = year / 400;
+    uint32_t yearOfEra = static_cast<uint32_t>(year - era * 400);
+    uint32_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + dayOfMonth - 1;
+    uint32_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    // Days from 0000-03-01 to 2000-01-01.
+    return era * 146097 + static_cast<int32_t>(dayOfEra) - 730425;
+  }
+  
   struct Date final {
+    ///
+    /// \brief The day of the week in the range 1...7, from Sunday.
+    /// \description As the DS3231's registers and the stored formats hold it. It can
+    ///   disagree with the date, so Core takes the day from derivedDayOfWeek() instead.
+    ///
     uint8_t dayOfWeek;
+    /// \brief The day of the month in the range 1...31.
     uint8_t dayOfMonth;
+    /// \brief The month in the range 1...12.
     uint8_t month;
+    /// \brief Years from 2000.
     uint8_t year;
+    
+    ///
+    /// \brief Days from 2000-01-01, ignoring the day of the week.
+    ///
+    constexpr uint32_t toDays() const {
+      return static_cast<uint32_t>(daysFromCivil(2000 + year, month, dayOfMonth));
+    }
+    
+    ///
+    /// \brief The date a number of days from 2000-01-01, with its day of the week.
+    /// \description Howard Hinnant's civil_from_days, the inverse of daysFromCivil.
+    ///
+    static constexpr Date fromDays(uint32_t days) {
+      // Days from 0000-03-01.
+      uint32_t day = days + 730425;
+      uint32_t era = day / 146097;
+      uint32_t dayOfEra = day - era * 146097;
+      uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+      uint32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+      uint32_t monthFromMarch = (5 * dayOfYear + 2) / 153;
+      uint32_t month = monthFromMarch < 10 ? monthFromMarch + 3 : monthFromMarch - 9;
+      uint32_t year = era * 400 + yearOfEra + (month <= 2);
+      return {
+        dayOfWeekFromDays(days),
+        static_cast<uint8_t>(dayOfYear - (153 * monthFromMarch + 2) / 5 + 1),
+        static_cast<uint8_t>(month),
+        static_cast<uint8_t>(year - 2000)
+      };
+    }
+    
+    ///
+    /// \brief The day of the week of the date, from the date alone.
+    ///
+    constexpr uint8_t derivedDayOfWeek() const { return dayOfWeekFromDays(toDays()); }
+    
+    ///
+    /// \brief Whether the date is a day of the clock's years, ignoring the day of the week.
+    ///
+    constexpr bool isValid() const {
+      return month >= 1 && month <= 12 && dayOfMonth >= 1 && year <= 99 &&
+        fromDays(toDays()).dayOfMonth == dayOfMonth;
+    }
+    
+    ///
+    /// \brief Whether two dates are the same day, ignoring the days of the week.
+    ///
+    friend constexpr bool operator==(const Date& date, const Date& other) {
+      return date.dayOfMonth == other.dayOfMonth && date.month == other.month && 
+        date.year == other.year;
+    }
+    
+  private:
+    static constexpr uint8_t dayOfWeekFromDays(uint32_t days) {
+      // 2000-01-01 was a Saturday, day 7.
+      return static_cast<uint8_t>((days + 6) % 7 + 1);
+    }
   }; // struct Date
   
+  static_assert(Date{7, 1, 1, 0}.toDays() == 0);
+  static_assert(Date{1, 1, 3, 0}.toDays() == 31 + 29);
+  static_assert(Date::fromDays(Date{2, 29, 2, 24}.toDays()) == Date{5, 29, 2, 24});
+  static_assert(Date::fromDays(Date{0, 29, 2, 24}.toDays()).dayOfWeek == 5);
+  static_assert(Date{0, 19, 10, 26}.derivedDayOfWeek() == 2);
+  static_assert(Date{0, 29, 2, 24}.isValid() && !Date{0, 29, 2, 25}.isValid());
+  static_assert(!Date{0, 31, 4, 26}.isValid() && !Date{0, 1, 13, 26}.isValid());
+  
   struct ClockDatum final {
     Time time;
     Date date;
+  }; // struct ClockDatum
+  
+  ///
+  /// \brief A date and time as seconds from 2000-01-01 00:00:00 of the clock's time.
+  /// \description For arithmetic, durations and comparison across dates. Runs to 2136.
+  ///
+  struct EpochSeconds final {
+    uint32_t value;
     
-    char* toString() {
-      std::tm tm{};
-      tm.tm_sec = time.seconds;
-      tm.tm_min = time.minutes;
-      tm.tm_hour = time.hour;
-      tm.tm_wday = date.dayOfWeek - 1;
-      tm.tm_mday = date.dayOfMonth;
-      tm.tm_mon = date.month - 1;
-      tm.tm_year = date.year + 100; // From 1900.
-      return std::asctime(&tm);
+    static constexpr EpochSeconds fromClockDatum(ClockDatum clockDatum) {
+      return {clockDatum.date.toDays() * Time::seconds_per_day + clockDatum.time.inSeconds()};
     }
-  }; // struct ClockDatum
+    
+    constexpr uint32_t days() const { return value / Time::seconds_per_day; }
+    constexpr Time time() const { return Time::fromSeconds(value % Time::seconds_per_day); }
+    constexpr Date date() const { return Date::fromDays(days()); }
+    constexpr ClockDatum toClockDatum() const { return {time(), date()}; }
+    
+    ///
+    /// \brief Seconds to the start of the next day.
+    ///
+    constexpr uint32_t secondsToMidnight() const { 
+      return Time::seconds_per_day - value % Time::seconds_per_day; 
+    }
+    
+    constexpr EpochSeconds operator+(int32_t seconds) const { 
+      return {value + static_cast<uint32_t>(seconds)}; 
+    }
+    constexpr EpochSeconds operator-(int32_t seconds) const { 
+      return {value - static_cast<uint32_t>(seconds)}; 
+    }
+    ///
+    /// \brief The seconds from another time to this one, negative when it is later.
+    ///
+    constexpr int64_t operator-(EpochSeconds other) const {
+      return static_cast<int64_t>(value) - other.value;
+    }
+    
+    friend constexpr auto operator<=>(const EpochSeconds& time, const EpochSeconds& other) = default;
+  }; // struct EpochSeconds
+  
+  static_assert(EpochSeconds::fromClockDatum({{59, 59, 23}, {0, 31, 12, 99}}) + 1 
+    == EpochSeconds::fromClockDatum({{0, 0, 0}, {0, 1, 1, 100}}));
+  static_assert(EpochSeconds{Time::seconds_per_day * 366 + 5}.toClockDatum().date == Date{2, 1, 1, 1});
 
 } // namespace Core
\ No newline at end of file
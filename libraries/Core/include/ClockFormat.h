@@ -0,0 +1,182 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#pragma once
+
+#include "Clock.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Core {
+
+  namespace ClockFormatting {
+    // Not constexpr, so calling it fails to compile.
+    void unknownField();
+  }; // namespace ClockFormatting
+  
+  ///
+  /// \brief A format for a clock datum, checked and sized when compiled.
+  /// \description The fields are those of strftime: %Y, %y, %m, %d, %e, %H, %M, %S, %a, 
+  ///   %b and %%. Each has a fixed width, so the text's length is known from the format, 
+  ///   and an unknown field fails to compile. There is no locale.
+  ///
+  template <size_t N>
+  struct ClockFormat final {
+    char spec[N];
+    
+    consteval ClockFormat(const char (&format)[N]) : spec{} {
+      for (size_t index = 0; index < N; ++index) {
+        spec[index] = format[index];
+      }
+      length();
+    }
+    
+    ///
+    /// \brief The length of the formatted text, without its terminator.
+    ///
+    consteval size_t length() const {
+      size_t length = 0;
+      for (size_t index = 0; index + 1 < N; ++index) {
+        if (spec[index] != '%') {
+          ++length;
+          continue;
+        }
+        ++index;
+        length += fieldWidth(spec[index]);
+      }
+      return length;
+    }
+    
+    static consteval size_t fieldWidth(char field) {
+      switch (field) {
+        case '%': return 1;
+        case 'Y': return 4;
+        case 'a': case 'b': return 3;
+        case 'y': case 'm': case 'd': case 'e': case 'H': case 'M': case 'S': return 2;
+        default: ClockFormatting::unknownField(); return 0;
+      }
+    }
+  }; // struct ClockFormat
+  
+  /// \brief ISO 8601 date and time, 2026-10-19T14:05:09.
+  inline constexpr ClockFormat iso8601_format{"%Y-%m-%dT%H:%M:%S"};
+  /// \brief ISO 8601 date, 2026-10-19.
+  inline constexpr ClockFormat date_format{"%Y-%m-%d"};
+  /// \brief Hours and minutes, 14:05.
+  inline constexpr ClockFormat hour_minute_format{"%H:%M"};
+  /// \brief The layout of asctime, Mon Oct 19 14:05:09 2026, with its newline.
+  inline constexpr ClockFormat asctime_format{"%a %b %e %H:%M:%S %Y\n"};
+  
+  ///
+  /// \brief Text for a clock datum, held by value.
+  /// \description A temporary's text lasts to the end of the statement, long enough for
+  ///   a printf.
+  ///
+  template <auto format>
+  struct ClockText final {
+    char text[format.length() + 1];
+    
+    constexpr const char* c_str() const { return text; }
+  }; // struct ClockText
+  
+  namespace ClockFormatting {
+    inline constexpr char day_names[] = "SunMonTueWedThuFriSat";
+    inline constexpr char month_names[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+    
+    constexpr char* putDigits(char* next, uint32_t value, char pad) {
+      next[0] = value >= 10 ? static_cast<char>('0' + value / 10 % 10) : pad;
+      next[1] = static_cast<char>('0' + value % 10);
+      return next + 2;
+    }
+    
+    constexpr char* putName(char* next, const char* names, uint32_t index, uint32_t count) {
+      // Out of range values show as ???, rather than reading past the names.
+      for (uint32_t character = 0; character < 3; ++character) {
+        next[character] = index < count ? names[index * 3 + character] : '?';
+      }
+      return next + 3;
+    }
+  }; // namespace ClockFormatting
+  
+  ///
+  /// \brief Format a clock datum into a buffer.
+  /// \description Writes to the caller's buffer only, so it is reentrant and safe from
+  ///   either core. The buffer's size is checked when compiled.
+  ///
+  /// \param buffer At least the format's length and a terminator.
+  /// \return The length of the text, without its terminator.
+  ///
+  template <auto format, size_t N>
+  constexpr size_t formatClock(ClockDatum clockDatum, char (&buffer)[N]) {
+    static_assert(N > format.length(), "The buffer is too small for the format");
+    using namespace ClockFormatting;
+    char* next = buffer;
+    for (size_t index = 0; format.spec[index] != '\0'; ++index) {
+      if (format.spec[index] != '%') {
+        *next++ = format.spec[index];
+        continue;
+      }
+      switch (format.spec[++index]) {
+        case '%': *next++ = '%'; break;
+        case 'Y': next = putDigits(putDigits(next, 20 + clockDatum.date.year / 100, '0'), 
+                                   clockDatum.date.year % 100, '0'); break;
+        case 'y': next = putDigits(next, clockDatum.date.year % 100, '0'); break;
+        case 'm': next = putDigits(next, clockDatum.date.month, '0'); break;
+        case 'd': next = putDigits(next, clockDatum.date.dayOfMonth, '0'); break;
+        case 'e': next = putDigits(next, clockDatum.date.dayOfMonth, ' '); break;
+        case 'H': next = putDigits(next, clockDatum.time.hour, '0'); break;
+        case 'M': next = putDigits(next, clockDatum.time.minutes, '0'); break;
+        case 'S': next = putDigits(next, clockDatum.time.seconds, '0'); break;
+        case 'a': next = putName(next, day_names, clockDatum.date.derivedDayOfWeek() - 1u, 7); break;
+        case 'b': next = putName(next, month_names, clockDatum.date.month - 1u, 12); break;
+      }
+    }
+    *next = '\0';
+    return static_cast<size_t>(next - buffer);
+  }
+  
+  ///
+  /// \brief Format a clock datum as text held by value.
+  ///
+  template <auto format>
+  constexpr ClockText<format> formatClock(ClockDatum clockDatum) {
+    ClockText<format> clockText{};
+    formatClock<format>(clockDatum, clockText.text);
+    return clockText;
+  }
+  
+  static_assert(iso8601_format.length() == 19);
+  static_assert(asctime_format.length() == 25);
+}; // namespace Core
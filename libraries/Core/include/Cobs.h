@@ -0,0 +1,102 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Core {
+
+///
+/// \brief The most bytes COBS encoding takes for data of a length.
+/// \description A code byte is added for each run of up to 254 bytes.
+///
+constexpr size_t cobsEncodedSize(size_t length) {
+  return length + length / 254 + 1;
+}
+
+///
+/// \brief Consistent Overhead Byte Stuffing of a block of data.
+/// \description The encoded data has no zero bytes, so a zero can delimit frames.
+///
+/// \param source The data to encode.
+/// \param length The length of the data in bytes.
+/// \param destination At least cobsEncodedSize(length) bytes for the encoded data.
+/// \return The length of the encoded data.
+///
+constexpr size_t cobsEncode(const uint8_t* source, size_t length, uint8_t* destination) {
+  size_t codeIndex = 0;
+  size_t index = 1;
+  uint8_t code = 1;
+  for (size_t sourceIndex = 0; sourceIndex < length; ++sourceIndex) {
+    if (source[sourceIndex] != 0) {
+      destination[index++] = source[sourceIndex];
+      ++code;
+    }
+    if (source[sourceIndex] == 0 || code == 0xff) {
+      destination[codeIndex] = code;
+      codeIndex = index++;
+      code = 1;
+    }
+  }
+  destination[codeIndex] = code;
+  return index;
+}
+
+///
+/// \brief Decode data encoded by cobsEncode, without its delimiter.
+/// \description The destination may be the source, decoding in place.
+///
+/// \return The length of the decoded data, or 0 if the data is not valid COBS.
+///
+constexpr size_t cobsDecode(const uint8_t* source, size_t length, uint8_t* destination) {
+  size_t index = 0;
+  size_t decodedLength = 0;
+  while (index < length) {
+    uint8_t code = source[index++];
+    if (code == 0 || index + code - 1 > length) {
+      return 0;
+    }
+    for (uint8_t count = 1; count < code; ++count) {
+      destination[decodedLength++] = source[index++];
+    }
+    if (code != 0xff && index < length) {
+      destination[decodedLength++] = 0;
+    }
+  }
+  return decodedLength;
+}
+
+}; // namespace Core
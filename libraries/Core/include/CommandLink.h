@@ -0,0 +1,103 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#pragma once
+
+#include "Cobs.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Core {
+
+class SerialPort;
+
+///
+/// \brief Binary requests and responses framed over a serial port.
+/// \description A frame is COBS encoded and delimited by a zero byte before and after,
+///   so text or noise between frames is dropped as a frame of its own. A request is an
+///   id chosen by the host, a command and its payload, and a response repeats the id and
+///   command followed by a status and its payload. Both end with a CRC-16 of the
+///   preceding bytes, little endian. Requests and responses carry at most
+///   maximum_payload bytes, so any request's payload can be echoed. Bytes are taken as
+///   they arrive, without waiting, into fixed buffers.
+///
+class CommandLink final {
+public:
+  static constexpr size_t maximum_payload = 160;
+  
+  enum class Status : uint8_t { ok, unknownCommand, badLength, badValue, failed };
+  
+  struct Request {
+    uint8_t id;
+    uint8_t command;
+    const uint8_t* payload;
+    size_t length;
+  }; // struct Request
+  
+  CommandLink(SerialPort& port) : port(port) {}
+  CommandLink(const CommandLink&) = delete;
+  ~CommandLink() = default;
+  
+  ///
+  /// \brief Take the bytes that have arrived, up to the end of a request.
+  /// \return True with the request when a valid one has arrived. Its payload is valid
+  ///   until the next poll.
+  ///
+  bool poll(Request& request);
+  void respond(const Request& request, Status status, const uint8_t* payload = nullptr,
+               size_t length = 0);
+  
+  ///
+  /// \brief The frames dropped for being too long, badly encoded or failing their CRC.
+  ///
+  uint32_t getFrameErrorCount() const { return frameErrorCount; }
+  
+private:
+  // The id and command, then the payload and CRC.
+  static constexpr size_t maximum_request = 2 + maximum_payload + 2;
+  // The id, command and status, then the payload and CRC.
+  static constexpr size_t maximum_response = 3 + maximum_payload + 2;
+  static constexpr size_t maximum_encoded = cobsEncodedSize(maximum_request);
+  
+  SerialPort& port;
+  uint8_t received[maximum_encoded];
+  size_t receivedLength = 0;
+  bool overflowed = false;
+  uint32_t frameErrorCount = 0;
+  
+  bool decode(Request& request);
+}; // class CommandLink
+
+}; // namespace Core
@@ -0,0 +1,152 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#pragma once
+
+#include "FlashRegion.h"
+#include "ScheduleCalendar.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Core {
+
+struct ControlConfiguration;
+
+///
+/// \brief A controller's schedule and settings as they are stored in flash.
+/// \description A fixed layout, used in place from the memory mapped flash.
+///
+struct StoredConfiguration final {
+  /// \brief The "on" state power level, see ControlConfiguration.
+  float powerLevel = 1.0f;
+  /// \brief The fade time in milliseconds, see ControlConfiguration.
+  uint32_t transitionDuration = 0;
+  /// \brief The location and the clock's offset from UTC for a SolarCalculator.
+  float latitude = 0.0f;
+  float longitude = 0.0f;
+  int16_t utcOffsetMinutes = 0;
+  uint8_t ruleCount = 0;
+  uint8_t exceptionCount = 0;
+  ScheduleRule rules[ScheduleCalendar::maximum_rules];
+  ScheduleException exceptions[ScheduleCalendar::maximum_exceptions];
+  
+  bool addRule(const ScheduleRule& rule);
+  bool addException(const ScheduleException& exception);
+  ///
+  /// \brief Whether every field is in range, so the configuration can be scheduled from.
+  /// \description Checks the counts, settings and location, and each rule's days, season,
+  ///   times and offsets, and each exception's date and times.
+  ///
+  bool isValid() const;
+  ///
+  /// \brief Set a configuration's settings and a calendar's rules and exceptions.
+  ///
+  void apply(ControlConfiguration& configuration, ScheduleCalendar& calendar) const;
+}; // struct StoredConfiguration
+
+static_assert(std::is_trivially_copyable_v<StoredConfiguration>);
+
+///
+/// \brief Keeps a StoredConfiguration in two slots of flash, one sector each.
+/// \description Each save goes to the slot not holding the configuration in use, with the
+///   next sequence number, so the configuration in use is never erased. A slot is checked
+///   by a magic number, format version, length and CRC-32, and loading takes the valid
+///   slot with the latest sequence, falling back to the other when a save was torn by a
+///   power loss or a slot is corrupted. A loaded configuration is read in place through
+///   the memory mapped flash, without copying it out.
+///
+class ConfigurationStore final {
+public:
+  static constexpr uint32_t slot_count = 2;
+  ///
+  /// \brief The format of the stored configuration.
+  /// \description Raised when StoredConfiguration changes, so configurations stored in
+  ///   an older format are not loaded.
+  ///
+  static constexpr uint16_t format_version = 1;
+  
+  ///
+  /// \param region A flash region of at least two sectors.
+  ///
+  ConfigurationStore(FlashRegion& region) : region(region) {}
+  ConfigurationStore(const ConfigurationStore&) = delete;
+  ~ConfigurationStore() = default;
+  
+  ///
+  /// \brief The latest valid configuration, or null if neither slot has one.
+  /// \description A slot that passes its checks but holds a configuration that is not
+  ///   valid is counted as corrupt.
+  ///
+  const StoredConfiguration* load();
+  ///
+  /// \brief Save a configuration to the slot not in use, then check it.
+  /// \return True if the configuration was saved, and is now the one in use. False, 
+  ///   without programming flash, if the configuration is not valid.
+  ///
+  bool save(const StoredConfiguration& configuration);
+  
+  ///
+  /// \brief The slot in use, or -1 before a configuration is loaded or saved.
+  ///
+  int getSlot() const { return slot; }
+  uint32_t getSequence() const { return sequence; }
+  ///
+  /// \brief The slots found holding data that failed their checks at the last load.
+  ///
+  uint32_t getCorruptSlotCount() const { return corruptSlotCount; }
+  
+private:
+  struct SlotHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t length;
+    uint32_t sequence;
+    /// \brief CRC of the preceding header fields and the configuration.
+    uint32_t crc;
+  };
+  static_assert(sizeof(SlotHeader) + sizeof(StoredConfiguration) <= FlashRegion::sector_size,
+    "A stored configuration must fit in a sector with its header.");
+  
+  FlashRegion& region;
+  int slot = -1;
+  uint32_t sequence = 0;
+  uint32_t corruptSlotCount = 0;
+  
+  const SlotHeader* validHeader(uint32_t slotIndex) const;
+  static uint32_t slotCrc(const SlotHeader& header, const uint8_t* data);
+}; // class ConfigurationStore
+
+}; // namespace Core
@@ -38,17 +38,87 @@
 
 #include "Clock.h"
 
+#include <cstddef>
+#include <cstdint>
+
 namespace Core {
 
-struct ControlConfiguration final {  
-  /// \brief The start time in a day to switch a device "on".
-  Time startTime = {0,0,0};
-  /// \brief The end time in a day to switch a device "off".
-  Time endTime = {0, 0, 0};
+class PowerDevice;
+
+///
+/// \brief The on/off schedule of a device for a day.
+/// \description The schedule is a set of windows in which a device is "on", kept sorted
+///   and merged so no two windows overlap or touch. A window that wraps past midnight is
+///   kept as a window to the end of the day and a window from its start, as for a schedule
+///   repeated each day. ScheduleCalendar, whose days differ, instead carries the part past
+///   midnight into the next day's windows. Storage is fixed, up to maximum_windows
+///   windows. The state at a time is found by a binary search, which also gives the span
+///   of the day over which the state holds, so a caller can skip further lookups until
+///   the span's end, the next transition.
+///
+struct ControlConfiguration final {
+  static constexpr size_t maximum_windows = 64;
+  static constexpr uint32_t seconds_per_day = Time::seconds_per_day;
+  
+  ///
+  /// \brief A window in which a device is "on".
+  /// \description The start and end are seconds of the day, both included in the window.
+  ///
+  struct Window {
+    uint32_t start;
+    uint32_t end;
+  }; // struct Window
+  
+  ///
+  /// \brief A span of the day over which a device's state does not change.
+  /// \description The span starts at the second of the day start and runs up to, but not
+  ///   including, end. The end is the next transition, or the end of the day.
+  ///
+  struct Span {
+    bool on;
+    uint32_t start;
+    uint32_t end;
+  }; // struct Span
+  
   /// \brief The "on" state power level.
   /// \description A power level for the "on" state for a device in the range of 0.0...1.0. This can
   /// be ignored by a device that only toggles between on and off.
   float powerLevel = 1.0;
+  /// \brief The time in milliseconds to fade between "off" and "on".
+  /// \description Used by devices that dim, so a window can open with a sunrise fade.
+  uint32_t transitionDuration = 0;
+  
+  ///
+  /// \brief Set a device's power level and transition duration to the configuration's.
+  /// \description The schedulers apply these when the revision changes, so a change to
+  ///   them is taken with the next change to the windows.
+  ///
+  void applyOutput(PowerDevice& powerDevice) const;
+  
+  bool addWindow(Time startTime, Time endTime);
+  void clearWindows();
+  
+  size_t getWindowCount() const { return windowCount; }
+  const Window& getWindow(size_t index) const { return windows[index]; }
+  ///
+  /// \brief A count of the changes made to the windows.
+  /// \description Lets a caller holding a span know when it is no longer valid.
+  ///
+  uint32_t getRevision() const { return revision; }
+  
+  Span find(uint32_t secondOfDay) const;
+  Span find(Time time) const { return find(time.inSeconds()); }
+  
+private:
+  Window windows[maximum_windows];
+  size_t windowCount = 0;
+  uint32_t revision = 0;
+  
+  bool insertWindow(uint32_t start, uint32_t end);
+  ///
+  /// \brief Whether a window would take a place of its own, rather than merge.
+  ///
+  bool needsWindow(uint32_t start, uint32_t end) const;
 }; // struct ControlConfiguration
 
-}; // namespace Core
\ No newline at end of file
+}; // namespace Core
@@ -0,0 +1,77 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Core {
+
+///
+/// \brief CRC-16/CCITT-FALSE of a block of data.
+///
+/// \param data The data to check.
+/// \param length The length of the data in bytes.
+/// \param crc The CRC of preceding data when checking data in parts.
+///
+constexpr uint16_t crc16(const uint8_t* data, size_t length, uint16_t crc = 0xffff) {
+  for (size_t index = 0; index < length; ++index) {
+    crc ^= static_cast<uint16_t>(data[index]) << 8;
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+  }
+  return crc;
+}
+
+///
+/// \brief CRC-32 of a block of data, the reflected 0xEDB88320 polynomial.
+///
+/// \param data The data to check.
+/// \param length The length of the data in bytes.
+/// \param crc The CRC of preceding data when checking data in parts.
+///
+constexpr uint32_t crc32(const uint8_t* data, size_t length, uint32_t crc = 0) {
+  crc = ~crc;
+  for (size_t index = 0; index < length; ++index) {
+    crc ^= data[index];
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+}; // namespace Core
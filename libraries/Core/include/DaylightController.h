@@ -0,0 +1,123 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#pragma once
+
+#include "PowerDevice.h"
+
+#include <cstdint>
+
+namespace Core {
+  ///
+  /// \brief Holds a target illuminance by dimming a lamp against the daylight.
+  /// \description A power device standing in for the lamp, so a scheduler switches it on
+  ///   and off by its windows as it would the lamp. While on, each update feeds a lux 
+  ///   reading into a PI controller whose output is the lamp's level, up to the power 
+  ///   level set by the scheduler. The integral is only accumulated while the output is
+  ///   free to move in the error's direction, so it does not wind up while the lamp is
+  ///   saturated or ramping, and the output is rate limited so the lamp does not step
+  ///   when clouds pass. The lamp is switched off when daylight alone nearly meets the
+  ///   target, and on again only when the shortfall is larger, with a least time 
+  ///   between switches, so a relay does not chatter.
+  ///
+  class DaylightController final : public PowerDevice {
+    public:
+      struct Tuning {
+        /// \brief The illuminance to hold at the sensor in lux.
+        float targetLux = 500.0f;
+        /// \brief The illuminance the lamp alone gives at the sensor at full level in lux.
+        /// \description Errors are scaled by it, so the gains are in levels.
+        float lampLux = 500.0f;
+        /// \brief Level per full lamp illuminance of error.
+        float proportionalGain = 0.5f;
+        /// \brief Level per second per full lamp illuminance of error.
+        float integralGain = 0.25f;
+        /// \brief The fastest the level changes, in level per second.
+        float rampRate = 0.05f;
+        /// \brief The lamp is switched off when the level falls to this.
+        float switchOffLevel = 0.05f;
+        /// \brief The lamp is switched on when the level it needs reaches this.
+        float switchOnLevel = 0.15f;
+        /// \brief The least time between switching the lamp in seconds.
+        float minimumSwitchSeconds = 120.0f;
+        /// \brief The longest time an update integrates and ramps over in seconds.
+        /// \description A reading later than this, as after the loop stalled, is taken
+        ///   as this long after the last, so the stall does not wind up the integral or
+        ///   step the lamp.
+        float maximumUpdateSeconds = 2.0f;
+      }; // struct Tuning
+      
+      DaylightController() = delete;
+      DaylightController(PowerDevice& lamp);
+      DaylightController(const DaylightController&) = delete;
+      
+      void setTuning(const Tuning& tuning) { this->tuning = tuning; }
+      const Tuning& getTuning() const { return tuning; }
+      
+      ///
+      /// \description On starts regulating from the lamp switched on, off switches the 
+      ///   lamp off.
+      ///
+      void setState(State) override;
+      
+      ///
+      /// \brief Regulate the lamp from a lux reading.
+      /// \description Called with each new reading, and the seconds since the last.
+      ///
+      void update(float lux, float seconds);
+      
+      ///
+      /// \brief The lamp's level, 0 while it is switched off.
+      ///
+      float getOutput() const { return lampOn ? output : 0.0f; }
+      ///
+      /// \brief The energy used over the time on, as a fraction of the lamp on at the power level.
+      ///
+      float getEnergyFraction() const;
+      uint32_t getSwitchCount() const { return switchCount; }
+      
+    private:
+      PowerDevice& lamp;
+      Tuning tuning;
+      bool lampOn = false;
+      float output = 0.0f;
+      float integral = 0.0f;
+      float secondsSinceSwitch = 0.0f;
+      uint32_t switchCount = 0;
+      double onSeconds = 0.0;
+      double levelSeconds = 0.0;
+      
+      void switchLamp(bool on);
+  }; // class DaylightController
+}; // namespace Core
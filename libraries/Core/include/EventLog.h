@@ -0,0 +1,168 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#pragma once
+
+#include "Clock.h"
+#include "FlashRegion.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Core {
+
+///
+/// \brief A fixed size binary record of a sensor reading or power change.
+///
+struct EventRecord final {
+  enum Type : uint8_t { sensorReading = 1, powerChange = 2 };
+  
+  /// \brief The date and time of the event.
+  ClockDatum clockDatum;
+  Type type;
+  /// \brief The light reading in thousandths of a lux.
+  uint32_t lux;
+  /// \brief The power state of the device, a PowerDevice::State.
+  uint8_t powerState;
+  uint8_t reserved;
+  /// \brief CRC of the preceding bytes, set when the record is appended.
+  uint16_t crc;
+}; // struct EventRecord
+
+static_assert(sizeof(EventRecord) == 16, "Event records must pack evenly into flash pages.");
+
+///
+/// \brief An append only log of event records in flash.
+/// \description The records are written around the sectors of a flash region in turn, so
+///   each sector is erased once per pass and wear is level across them. Each sector starts
+///   with a header with the sequence number of the pass, and the newest sector is found
+///   from these after a restart.
+///
+///   Records are staged in RAM and the page is programmed when it fills or on flush(),
+///   leaving the rest of the page erased for later records. A record torn by a power loss
+///   fails its CRC and is skipped, and appending resumes after the last programmed slot.
+///
+///   Flash sectors are rated for 100,000 erases and hold 255 records, so a region of
+///   N sectors wears out after about 25.5 million * N records. For 16 sectors at one
+///   record a minute that is over 700 years.
+///
+class EventLog {
+public:
+  static constexpr uint32_t record_size = sizeof(EventRecord);
+  static constexpr uint32_t slots_per_sector = FlashRegion::sector_size / record_size;
+  static constexpr uint32_t slots_per_page = FlashRegion::page_size / record_size;
+  
+  EventLog(FlashRegion& region) : region(region) {}
+  EventLog(const EventLog&) = delete;
+  ~EventLog() = default;
+  
+  ///
+  /// \brief Recover the position to append at from the flash contents.
+  ///
+  void init();
+  
+  void append(EventRecord record);
+  ///
+  /// \brief Program staged records into flash.
+  ///
+  void flush();
+  ///
+  /// \brief The records appended but not yet programmed, lost at a power loss.
+  ///
+  uint32_t getStagedCount() const { return nextSlot - stagedSlot; }
+  
+  ///
+  /// \brief Visit each valid record from oldest to newest, including staged records.
+  ///
+  /// \param visitor A callable taking a const EventRecord&.
+  ///
+  template <typename Visitor>
+  void forEach(Visitor visitor) const {
+    uint32_t sectorCount = region.getSectorCount();
+    for (uint32_t step = 1; step <= sectorCount; ++step) {
+      uint32_t sectorIndex = (headSector + step) % sectorCount;
+      auto sector = region.sector(sectorIndex);
+      if (!isValidHeader(sector) || header(sector).sequence > sequence) {
+        continue;
+      }
+      for (uint32_t slot = 1; slot < slots_per_sector; ++slot) {
+        if (sectorIndex == headSector && slot >= stagedSlot) {
+          break;
+        }
+        auto& record = *reinterpret_cast<const EventRecord*>(&sector[slot * record_size]);
+        if (isValidRecord(record)) {
+          visitor(record);
+        }
+      }
+    }
+    
+    for (uint32_t slot = stagedSlot; slot < nextSlot; ++slot) {
+      visitor(staging[slot % slots_per_page]);
+    }
+  }
+  
+private:
+  struct SectorHeader {
+    uint32_t magic;
+    uint32_t sequence;
+    uint8_t reserved[6];
+    uint16_t crc;
+  };
+  static_assert(sizeof(SectorHeader) == record_size);
+  
+  FlashRegion& region;
+  /// \brief The sector being appended to.
+  uint32_t headSector = 0;
+  /// \brief The sequence number of the head sector.
+  uint32_t sequence = 0;
+  /// \brief The slot in the head sector for the next record.
+  uint32_t nextSlot = 1;
+  /// \brief The first slot in the staging page not yet programmed.
+  uint32_t stagedSlot = 1;
+  /// \brief True once the head sector has been erased and its header staged.
+  bool headStarted = false;
+  /// \brief The page being staged. Unused slots are erased values.
+  EventRecord staging[slots_per_page];
+  
+  static const SectorHeader& header(const uint8_t* sector) {
+    return *reinterpret_cast<const SectorHeader*>(sector);
+  }
+  static bool isValidHeader(const uint8_t* sector);
+  static bool isValidRecord(const EventRecord& record);
+  
+  void startNextSector();
+  void clearStaging();
+}; // class EventLog
+
+}; // namespace Core
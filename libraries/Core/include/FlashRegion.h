@@ -0,0 +1,82 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Core {
+
+///
+/// \brief A range of sectors in the on-board flash reserved for data.
+/// \description Reads are directly from the memory mapped flash. Erasing and programming
+///   stall execution from flash, so interrupts are disabled while they run. The region
+///   must not overlap the program image.
+///
+class FlashRegion {
+public:
+  static constexpr uint32_t sector_size = 4096;
+  static constexpr uint32_t page_size = 256;
+  static constexpr uint32_t pages_per_sector = sector_size / page_size;
+  
+  ///
+  /// \param offset The offset of the region from the start of flash, on a sector boundary.
+  /// \param sectorCount The number of sectors in the region.
+  ///
+  FlashRegion(uint32_t offset, uint32_t sectorCount) : offset(offset), sectorCount(sectorCount) {}
+  FlashRegion(const FlashRegion&) = delete;
+  ~FlashRegion() = default;
+  
+  uint32_t getSectorCount() const { return sectorCount; }
+  
+  ///
+  /// \brief Accessor to the memory mapped contents of a sector.
+  ///
+  const uint8_t* sector(uint32_t index) const;
+  
+  void eraseSector(uint32_t index);
+  ///
+  /// \brief Program a page of a sector. 
+  /// \description Flash bits can only be programmed from erased, so bytes to leave as they
+  ///   are should be 0xff.
+  ///
+  void programPage(uint32_t sectorIndex, uint32_t pageIndex, const uint8_t* data);
+  
+private:
+  uint32_t offset;
+  uint32_t sectorCount;
+}; // class FlashRegion
+
+}; // namespace Core
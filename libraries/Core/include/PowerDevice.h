@@ -36,6 +36,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 namespace Core {
 
 ///
@@ -57,9 +59,19 @@ public:
 
   virtual void setState(State) = 0;
   
-  void setPowerLevel(float level) { powerLevel = level; }
+  ///
+  /// \description Sets the level for the "on" state. A device that dims applies it, fading
+  ///   to it when on, and one that only toggles ignores it.
+  ///
+  virtual void setPowerLevel(float level) { powerLevel = level; }
   float getPowerLevel() const { return powerLevel; }
   
+  ///
+  /// \description Sets the time a dimming device takes to fade between levels and states.
+  ///
+  void setTransitionDuration(uint32_t milliseconds) { transitionDuration = milliseconds; }
+  uint32_t getTransitionDuration() const { return transitionDuration; }
+  
   ///
   /// \description Accessor to the status of the device.
   /// \return The state of the device.
@@ -71,6 +83,8 @@ protected:
   State status = off;
   /// \brief The power level to set the device. Range: 0.0...1.0, Default: 1.0
   float powerLevel = 1.0;
+  /// \brief The fade time in milliseconds for a dimming device. Default: 0
+  uint32_t transitionDuration = 0;
 }; // class PowerDevice
 
 }; // namespace Core
\ No newline at end of file
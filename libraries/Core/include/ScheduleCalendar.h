@@ -0,0 +1,143 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#pragma once
+
+#include "Clock.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Core {
+
+struct ControlConfiguration;
+class SolarCalculator;
+
+///
+/// \brief A day of the year without the year.
+///
+struct MonthDay final {
+  /// \brief The month in the range 1...12.
+  uint8_t month;
+  /// \brief The day of the month in the range 1...31.
+  uint8_t dayOfMonth;
+}; // struct MonthDay
+
+///
+/// \brief A window repeated on days of the week through a season.
+/// \description The season runs from the first day to the last day, both included, and
+///   wraps around the end of the year when the last day is before the first. The start 
+///   and end are each a time of day, or sunrise or sunset with an offset in minutes, which
+///   can move it onto the day before or after. The window wraps past midnight into the 
+///   next day when the end is before the start.
+///   The days of the week and season are those of the day the window starts.
+///
+struct ScheduleRule final {
+  enum class Anchor : uint8_t { clockTime, sunrise, sunset };
+  /// \brief The furthest an anchored start or end can be from its sunrise or sunset.
+  static constexpr int16_t maximum_offset_minutes = 12 * 60;
+  
+  /// \brief Flags for the days of the week, with Sunday as day 1 of the clock's date.
+  enum DaysOfWeek : uint8_t {
+    sunday = 0x01, monday = 0x02, tuesday = 0x04, wednesday = 0x08, 
+    thursday = 0x10, friday = 0x20, saturday = 0x40,
+    weekdays = monday | tuesday | wednesday | thursday | friday,
+    weekends = saturday | sunday,
+    everyDay = weekdays | weekends
+  };
+  
+  uint8_t daysOfWeek = everyDay;
+  MonthDay firstDay = {1, 1};
+  MonthDay lastDay = {12, 31};
+  Time startTime = {0, 0, 0};
+  Time endTime = {0, 0, 0};
+  Anchor startAnchor = Anchor::clockTime;
+  Anchor endAnchor = Anchor::clockTime;
+  /// \brief Minutes after the start's sunrise or sunset, negative for before.
+  int16_t startOffsetMinutes = 0;
+  /// \brief Minutes after the end's sunrise or sunset, negative for before.
+  int16_t endOffsetMinutes = 0;
+}; // struct ScheduleRule
+
+///
+/// \brief A one-off window on a date, such as a holiday.
+/// \description The exceptions on a date replace the rules for it. An exception marked off
+///   has no window, so the device is off all day unless other exceptions add windows.
+///
+struct ScheduleException final {
+  Date date = {0, 0, 0, 0};
+  bool off = false;
+  Time startTime = {0, 0, 0};
+  Time endTime = {0, 0, 0};
+}; // struct ScheduleException
+
+///
+/// \brief Calendar rules for a device's schedule.
+/// \description The rules are compiled into the windows of a ControlConfiguration for one
+///   day at a time, so the rules are only evaluated once a day and finding the state at a
+///   time stays a search of the day's windows.
+///
+class ScheduleCalendar final {
+public:
+  static constexpr size_t maximum_rules = 32;
+  static constexpr size_t maximum_exceptions = 32;
+  
+  ScheduleCalendar() = default;
+  ~ScheduleCalendar() = default;
+  
+  ///
+  /// \return False if there is no room for the rule, or its offsets are too far.
+  ///
+  bool addRule(const ScheduleRule& rule);
+  bool addException(const ScheduleException& exception);
+  void clear();
+  ///
+  /// \brief The calculator for rules anchored to sunrise or sunset.
+  /// \description Without one, these rules are skipped.
+  ///
+  void setSolarCalculator(SolarCalculator& calculator) { solarCalculator = &calculator; }
+  
+  void compile(Date date, ControlConfiguration& configuration) const;
+  
+private:
+  ScheduleRule rules[maximum_rules];
+  size_t ruleCount = 0;
+  ScheduleException exceptions[maximum_exceptions];
+  size_t exceptionCount = 0;
+  SolarCalculator* solarCalculator = nullptr;
+  
+  void addWindows(Date day, int32_t dayStart, ControlConfiguration& configuration) const;
+}; // class ScheduleCalendar
+
+}; // namespace Core
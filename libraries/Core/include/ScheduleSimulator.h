@@ -0,0 +1,108 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#pragma once
+
+#include "Clock.h"
+#include "PowerDevice.h"
+#include "RecordingPowerDevice.h"
+#include "TimeScheduler.h"
+#include "VirtualClockDevice.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace Core {
+  ///
+  /// \brief A change of state found by a ScheduleSimulator.
+  ///
+  struct ScheduleTransition final {
+    ClockDatum clockDatum;
+    PowerDevice::State state;
+  }; // struct ScheduleTransition
+  
+  ///
+  /// \brief Runs a TimeScheduler over a range of dates without waiting for them.
+  /// \description The scheduler is built on a virtual clock and a recording power device.
+  ///   After each update the clock jumps to the scheduler's next transition, or the next
+  ///   midnight when there is none left in the day, so a day costs a few updates however
+  ///   its windows are spread. Built for the host only, by the tests and ScheduleReport.
+  ///
+  class ScheduleSimulator final {
+    public:
+      ScheduleSimulator() = delete;
+      ScheduleSimulator(TimeScheduler& scheduler, VirtualClockDevice& clockDevice,
+                        RecordingPowerDevice& powerDevice)
+        : scheduler(scheduler), clockDevice(clockDevice), powerDevice(powerDevice) {}
+      
+      ///
+      /// \brief Simulate from the start up to, but not including, the end.
+      /// \description The device's state at the start is visited as the first transition.
+      ///
+      /// \param visitor A callable taking a const ScheduleTransition&.
+      /// \return The number of scheduler updates made.
+      ///
+      template <typename Visitor>
+      uint32_t run(ClockDatum start, ClockDatum end, Visitor visitor) {
+        clockDevice.write(start);
+        scheduler.reset();
+        uint32_t updateCount = 0;
+        auto changeCount = powerDevice.getChangeCount();
+        bool first = true;
+        while (isBefore(clockDevice.read(), end)) {
+          scheduler.update();
+          ++updateCount;
+          if (first || powerDevice.getChangeCount() != changeCount) {
+            visitor(ScheduleTransition{clockDevice.read(), powerDevice.getStatus()});
+            changeCount = powerDevice.getChangeCount();
+            first = false;
+          }
+          clockDevice.advance(std::min(scheduler.getSecondsToNextTransition(), 
+                                       secondsUntil(clockDevice.read(), end)));
+        }
+        return updateCount;
+      }
+      
+    private:
+      TimeScheduler& scheduler;
+      VirtualClockDevice& clockDevice;
+      RecordingPowerDevice& powerDevice;
+      
+      static bool isBefore(ClockDatum clockDatum, ClockDatum end);
+      ///
+      /// \brief Seconds to the end, at most to the end of the day.
+      ///
+      static uint32_t secondsUntil(ClockDatum clockDatum, ClockDatum end);
+  }; // class ScheduleSimulator
+}; // namespace Core
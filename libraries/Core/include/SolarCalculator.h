@@ -0,0 +1,101 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#pragma once
+
+#include "Clock.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Core {
+
+///
+/// \brief Sunrise and sunset for a location.
+/// \description Uses NOAA's sunrise equation in single precision, with the sun's 
+///   declination and the equation of time from the Astronomical Almanac's low precision
+///   solar coordinates. Sunrise and sunset are for the sun's center 0.833 degrees below
+///   the horizon, allowing for refraction and the sun's radius, and are within seconds of
+///   the full NOAA calculation away from the poles. The times for the last few dates are
+///   cached, so a daily schedule computes them once for each date.
+///
+class SolarCalculator final {
+public:
+  ///
+  /// \brief Sunrise and sunset in seconds of the local day.
+  /// \description With no sunrise, in polar night, both are at solar noon. With no sunset,
+  ///   in polar day, sunrise is at the start of the day and sunset at its end.
+  ///
+  struct SolarTimes {
+    uint32_t sunrise;
+    uint32_t sunset;
+  }; // struct SolarTimes
+  
+  ///
+  /// \param latitude The latitude in degrees, positive north.
+  /// \param longitude The longitude in degrees, positive east.
+  /// \param utcOffsetMinutes The offset of the clock's local time from UTC in minutes.
+  ///
+  SolarCalculator(float latitude, float longitude, int16_t utcOffsetMinutes)
+    : latitude(latitude), longitude(longitude), utcOffsetMinutes(utcOffsetMinutes) {}
+  ~SolarCalculator() = default;
+  
+  void setLocation(float latitude, float longitude, int16_t utcOffsetMinutes) {
+    this->latitude = latitude;
+    this->longitude = longitude;
+    this->utcOffsetMinutes = utcOffsetMinutes;
+    for (auto& entry : cache) {
+      entry.date = {0, 0, 0, 0};
+    }
+  }
+  
+  const SolarTimes& calculate(Date date);
+  
+private:
+  float latitude;
+  float longitude;
+  int16_t utcOffsetMinutes;
+  
+  /// \brief Enough for a calendar's compile, which takes a date and its neighbours.
+  static constexpr size_t cache_size = 4;
+  struct CacheEntry {
+    Date date;
+    SolarTimes times;
+  }; // struct CacheEntry
+  
+  CacheEntry cache[cache_size] = {};
+  size_t nextCacheIndex = 0;
+}; // class SolarCalculator
+
+}; // namespace Core
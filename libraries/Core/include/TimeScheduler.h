@@ -34,21 +34,74 @@
 
 #pragma once
 
+#include "Clock.h"
+#include "ControlConfiguration.h"
+
+#include <cstdint>
+
 namespace Core {
+  class AlarmClockDevice;
   class PowerDevice;
   class RealTimeClockDevice;
-  class ControlConfiguration;
+  class ScheduleCalendar;
   
   class TimeScheduler final {
     public:
       TimeScheduler() = delete;
       TimeScheduler(PowerDevice&, RealTimeClockDevice&, ControlConfiguration&);
+      ///
+      /// \brief A scheduler that arms an alarm for each next transition.
+      /// \description Lets a caller sleep until the alarm's interrupt instead of a timer.
+      ///
+      TimeScheduler(PowerDevice&, RealTimeClockDevice&, ControlConfiguration&, AlarmClockDevice&);
+      
+      ///
+      /// \brief Schedule from calendar rules.
+      /// \description The rules are compiled into the configuration's windows for the
+      ///   current date at the next update, and again each time the date changes.
+      ///
+      void setCalendar(ScheduleCalendar& calendar);
       
       void update();
+      ///
+      /// \brief Search the schedule again at the next update, as after the clock is set.
+      ///
+      void reset();
+      
+      ///
+      /// \brief Hold the power device in a state until the next transition.
+      /// \description Taken at the next update. The schedule takes over again at the next
+      ///   transition, at midnight, or when the configuration changes.
+      ///
+      void setOverride(bool on);
+      void clearOverride() { overridden = false; }
+      bool isOverridden() const { return overridden; }
+      
+      ///
+      /// \brief The second of the day of the next transition, as of the last update.
+      /// \description The end of the day when no transition is left in the day.
+      ///
+      uint32_t getNextTransition() const { return span.end; }
+      ///
+      /// \brief Seconds from the time of the last update to the next transition.
+      /// \description A caller can sleep this long before the next update without missing
+      ///   a change of state. At least 1 second, as times are read to the second.
+      ///
+      uint32_t getSecondsToNextTransition() const { return span.end - currentSecond; }
       
     private:
       PowerDevice& powerDevice;
       RealTimeClockDevice& timeDevice;
       ControlConfiguration& configuration;
+      AlarmClockDevice* alarmDevice = nullptr;
+      ScheduleCalendar* calendar = nullptr;
+      /// \brief The date the calendar was last compiled for.
+      Date compiledDate = {0, 0, 0, 0};
+      /// \brief The span the last update fell in, empty until the first update.
+      ControlConfiguration::Span span = {false, 1, 0};
+      uint32_t revision = 0;
+      uint32_t currentSecond = 0;
+      bool overridden = false;
+      bool overrideOn = false;
   }; // class TimeScheduler
 }; // namespace Core
\ No newline at end of file
@@ -0,0 +1,68 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#pragma once
+
+#include "Clock.h"
+#include "RealTimeClockDevice.h"
+
+#include <cstdint>
+
+namespace Core {
+
+///
+/// \brief A clock that only moves when it is told to.
+/// \description Stands in for a real time clock when simulating a schedule, so time can
+///   jump straight to the next event. Built for the host only.
+///
+class VirtualClockDevice final : public RealTimeClockDevice {
+public:
+  VirtualClockDevice() = default;
+  ~VirtualClockDevice() = default;
+  
+  Time readTime() override { return clockDatum.time; }
+  Date readDate() override { return clockDatum.date; }
+  ClockDatum read() override { return clockDatum; }
+  void write(ClockDatum clockDatum) override { this->clockDatum = clockDatum; }
+  
+  ///
+  /// \brief Move the clock forward, through the days, months and years it passes.
+  ///
+  void advance(uint32_t seconds);
+  
+private:
+  ClockDatum clockDatum = {{0, 0, 0}, {7, 1, 1, 0}};
+}; // class VirtualClockDevice
+
+}; // namespace Core
@@ -0,0 +1,110 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "ChannelScheduler.h"
+
+#include "RealTimeClockDevice.h"
+
+#include <algorithm>
+
+using namespace Core;
+
+ChannelScheduler::ChannelScheduler(RealTimeClockDevice& timeDevice) : timeDevice(timeDevice) {}
+
+bool ChannelScheduler::addChannel(PowerDevice& powerDevice, 
+                                  const ControlConfiguration& configuration) 
+{
+  if (channelCount == maximum_channels) {
+    return false;
+  }
+  auto configurationIndex = static_cast<size_t>(
+    std::find(&configurations[0], &configurations[configurationCount], &configuration) -
+    &configurations[0]);
+  if (configurationIndex == configurationCount) {
+    configurations[configurationCount] = &configuration;
+    configurationRevisions[configurationCount] = configuration.getRevision();
+    ++configurationCount;
+  }
+  
+  configuration.applyOutput(powerDevice);
+  devices[channelCount] = &powerDevice;
+  configurationIndexes[channelCount] = static_cast<uint16_t>(configurationIndex);
+  // An empty span, so the channel is searched at the next update.
+  spanStarts[channelCount] = 1;
+  spanEnds[channelCount] = 0;
+  revisions[channelCount] = configuration.getRevision();
+  states[channelCount] = powerDevice.getStatus() == PowerDevice::on;
+  ++channelCount;
+  return true;
+}
+
+///
+/// \description The clock and each configuration's revision are read once. A channel 
+///   whose span still holds the time, with an unchanged configuration, costs three 
+///   compares. Others are searched, and their devices set if the state found differs.
+///   A channel whose configuration has changed takes its power level and transition
+///   duration first.
+///
+size_t ChannelScheduler::update() {
+  currentSecond = timeDevice.readTime().inSeconds();
+  nextTransition = ControlConfiguration::seconds_per_day;
+  for (size_t index = 0; index < configurationCount; ++index) {
+    configurationRevisions[index] = configurations[index]->getRevision();
+  }
+  
+  size_t changeCount = 0;
+  for (size_t channel = 0; channel < channelCount; ++channel) {
+    auto configurationIndex = configurationIndexes[channel];
+    if (currentSecond < spanStarts[channel] || currentSecond >= spanEnds[channel] ||
+      configurationRevisions[configurationIndex] != revisions[channel]) 
+    {
+      auto& configuration = *configurations[configurationIndex];
+      if (configurationRevisions[configurationIndex] != revisions[channel]) {
+        configuration.applyOutput(*devices[channel]);
+        revisions[channel] = configurationRevisions[configurationIndex];
+      }
+      auto span = configuration.find(currentSecond);
+      spanStarts[channel] = span.start;
+      spanEnds[channel] = span.end;
+      if (span.on != states[channel]) {
+        states[channel] = span.on;
+        auto state = span.on ? PowerDevice::on : PowerDevice::off;
+        devices[channel]->setState(state);
+        changes[changeCount++] = {static_cast<uint16_t>(channel), state};
+      }
+    }
+    nextTransition = std::min(nextTransition, spanEnds[channel]);
+  }
+  return changeCount;
+}
@@ -0,0 +1,70 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "Clock.h"
+
+using namespace Core;
+
+// The clock's two digit years from 2000 to 2099, checked a day at a time.
+constexpr uint32_t checkedDays = 36525;
+
+///
+/// \brief Check every date the clock can hold converts to days and back.
+/// \description Each day must follow the last, and its day of the week the last one's.
+///
+static constexpr bool checkCalendar() {
+  Date previous = Date::fromDays(0);
+  for (uint32_t days = 1; days < checkedDays; ++days) {
+    auto date = Date::fromDays(days);
+    if (date.toDays() != days || date.dayOfWeek != previous.dayOfWeek % 7 + 1) {
+      return false;
+    }
+    bool nextDay = date.year == previous.year && date.month == previous.month && 
+      date.dayOfMonth == previous.dayOfMonth + 1;
+    bool nextMonth = date.year == previous.year && date.month == previous.month + 1 && 
+      date.dayOfMonth == 1;
+    bool nextYear = date.year == previous.year + 1 && date.month == 1 && date.dayOfMonth == 1 &&
+      previous.month == 12 && previous.dayOfMonth == 31;
+    if (!nextDay && !nextMonth && !nextYear) {
+      return false;
+    }
+    if (!nextDay && previous.dayOfMonth < 28) {
+      return false;
+    }
+    previous = date;
+  }
+  return previous == Date{5, 31, 12, 99};
+}
+
+static_assert(checkCalendar());
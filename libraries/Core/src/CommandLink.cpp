@@ -0,0 +1,119 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "CommandLink.h"
+
+#include "Cobs.h"
+#include "Crc.h"
+#include "SerialPort.h"
+
+#include <cstring>
+
+using namespace Core;
+
+constexpr uint8_t frame_delimiter = 0;
+constexpr size_t crc_size = 2;
+
+bool CommandLink::poll(Request& request) {
+  int byte;
+  while ((byte = port.read()) >= 0) {
+    if (byte != frame_delimiter) {
+      if (receivedLength < maximum_encoded) {
+        received[receivedLength++] = static_cast<uint8_t>(byte);
+      } else {
+        overflowed = true;
+      }
+      continue;
+    }
+    
+    bool valid = receivedLength > 0 && !overflowed && decode(request);
+    if (receivedLength > 0 && !valid) {
+      ++frameErrorCount;
+    }
+    receivedLength = 0;
+    overflowed = false;
+    if (valid) {
+      return true;
+    }
+  }
+  return false;
+}
+
+///
+/// \brief Decode a received frame in place into a request.
+///
+bool CommandLink::decode(Request& request) {
+  size_t length = cobsDecode(received, receivedLength, received);
+  if (length < 2 + crc_size || length > maximum_request) {
+    return false;
+  }
+  length -= crc_size;
+  uint16_t crc = received[length] | static_cast<uint16_t>(received[length + 1]) << 8;
+  if (crc != crc16(received, length)) {
+    return false;
+  }
+  
+  request.id = received[0];
+  request.command = received[1];
+  request.payload = &received[2];
+  request.length = length - 2;
+  return true;
+}
+
+void CommandLink::respond(const Request& request, Status status, const uint8_t* payload,
+                          size_t length) 
+{
+  if (length > maximum_payload) {
+    length = 0;
+    status = Status::failed;
+  }
+  
+  uint8_t frame[maximum_response];
+  frame[0] = request.id;
+  frame[1] = request.command;
+  frame[2] = static_cast<uint8_t>(status);
+  if (length > 0) {
+    std::memcpy(&frame[3], payload, length);
+  }
+  length += 3;
+  auto crc = crc16(frame, length);
+  frame[length++] = static_cast<uint8_t>(crc);
+  frame[length++] = static_cast<uint8_t>(crc >> 8);
+  
+  uint8_t encoded[cobsEncodedSize(maximum_response) + 2];
+  encoded[0] = frame_delimiter;
+  size_t encodedLength = 1 + cobsEncode(frame, length, &encoded[1]);
+  encoded[encodedLength++] = frame_delimiter;
+  port.write(encoded, encodedLength);
+}
@@ -0,0 +1,220 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "ConfigurationStore.h"
+
+#include "ControlConfiguration.h"
+#include "Crc.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+using namespace Core;
+
+constexpr uint32_t slot_magic = 0x43464731; // "CFG1"
+// UTC offsets run from -12:00 to +14:00.
+constexpr int16_t minimum_utc_offset_minutes = -12 * 60;
+constexpr int16_t maximum_utc_offset_minutes = 14 * 60;
+
+static bool isValid(MonthDay monthDay) {
+  // In a leap year, so the 29th of February can start or end a season.
+  return Date{0, monthDay.dayOfMonth, monthDay.month, 0}.isValid();
+}
+
+static bool isValid(ScheduleRule::Anchor anchor) {
+  return anchor == ScheduleRule::Anchor::clockTime || anchor == ScheduleRule::Anchor::sunrise ||
+    anchor == ScheduleRule::Anchor::sunset;
+}
+
+static bool isValid(int16_t offsetMinutes) {
+  return offsetMinutes >= -ScheduleRule::maximum_offset_minutes && 
+    offsetMinutes <= ScheduleRule::maximum_offset_minutes;
+}
+
+static bool isValid(const ScheduleRule& rule) {
+  return (rule.daysOfWeek & ~ScheduleRule::everyDay) == 0 && isValid(rule.firstDay) && 
+    isValid(rule.lastDay) && rule.startTime.isValid() && rule.endTime.isValid() &&
+    isValid(rule.startAnchor) && isValid(rule.endAnchor) && 
+    isValid(rule.startOffsetMinutes) && isValid(rule.endOffsetMinutes);
+}
+
+static bool isValid(const ScheduleException& exception) {
+  return exception.date.isValid() && exception.startTime.isValid() && 
+    exception.endTime.isValid();
+}
+
+bool StoredConfiguration::addRule(const ScheduleRule& rule) {
+  if (ruleCount == ScheduleCalendar::maximum_rules) {
+    return false;
+  }
+  rules[ruleCount++] = rule;
+  return true;
+}
+
+bool StoredConfiguration::addException(const ScheduleException& exception) {
+  if (exceptionCount == ScheduleCalendar::maximum_exceptions) {
+    return false;
+  }
+  exceptions[exceptionCount++] = exception;
+  return true;
+}
+
+bool StoredConfiguration::isValid() const {
+  // Written so that NaN fails each comparison.
+  if (ruleCount > ScheduleCalendar::maximum_rules || 
+    exceptionCount > ScheduleCalendar::maximum_exceptions ||
+    !(powerLevel >= 0.0f && powerLevel <= 1.0f) || 
+    !(latitude >= -90.0f && latitude <= 90.0f) || 
+    !(longitude >= -180.0f && longitude <= 180.0f) ||
+    utcOffsetMinutes < minimum_utc_offset_minutes || 
+    utcOffsetMinutes > maximum_utc_offset_minutes) 
+  {
+    return false;
+  }
+  return std::all_of(&rules[0], &rules[ruleCount], 
+                     [](const ScheduleRule& rule) { return ::isValid(rule); }) &&
+    std::all_of(&exceptions[0], &exceptions[exceptionCount], 
+                [](const ScheduleException& exception) { return ::isValid(exception); });
+}
+
+void StoredConfiguration::apply(ControlConfiguration& configuration, 
+                                ScheduleCalendar& calendar) const 
+{
+  configuration.powerLevel = powerLevel;
+  configuration.transitionDuration = transitionDuration;
+  // Cleared so the schedulers take the new level and duration at their next update, when
+  // the calendar is compiled into the windows again.
+  configuration.clearWindows();
+  calendar.clear();
+  for (size_t index = 0; index < ruleCount; ++index) {
+    calendar.addRule(rules[index]);
+  }
+  for (size_t index = 0; index < exceptionCount; ++index) {
+    calendar.addException(exceptions[index]);
+  }
+}
+
+///
+/// \description Each slot's header and CRC are checked, which reads the configuration once
+///   through the memory mapped flash. Sequences are compared by their difference, so they
+///   can wrap.
+///
+const StoredConfiguration* ConfigurationStore::load() {
+  slot = -1;
+  corruptSlotCount = 0;
+  const SlotHeader* latest = nullptr;
+  for (uint32_t slotIndex = 0; slotIndex < slot_count; ++slotIndex) {
+    auto header = validHeader(slotIndex);
+    if (header == nullptr) {
+      auto sector = region.sector(slotIndex);
+      if (std::any_of(sector, sector + sizeof(SlotHeader), [](uint8_t byte) { return byte != 0xff; })) {
+        ++corruptSlotCount;
+      }
+      continue;
+    }
+    if (!reinterpret_cast<const StoredConfiguration*>(header + 1)->isValid()) {
+      ++corruptSlotCount;
+      continue;
+    }
+    if (latest == nullptr || static_cast<int32_t>(header->sequence - latest->sequence) > 0) {
+      latest = header;
+      slot = static_cast<int>(slotIndex);
+    }
+  }
+  
+  if (latest == nullptr) {
+    return nullptr;
+  }
+  sequence = latest->sequence;
+  return reinterpret_cast<const StoredConfiguration*>(latest + 1);
+}
+
+///
+/// \description The slot is programmed a page at a time, from the header followed by the
+///   configuration, and is only taken into use once it reads back valid. A save torn by a
+///   power loss leaves the slot in use as it was.
+///
+bool ConfigurationStore::save(const StoredConfiguration& configuration) {
+  if (!configuration.isValid()) {
+    return false;
+  }
+  uint32_t slotIndex = slot < 0 ? 0 : (static_cast<uint32_t>(slot) + 1) % slot_count;
+  auto data = reinterpret_cast<const uint8_t*>(&configuration);
+  
+  SlotHeader header;
+  header.magic = slot_magic;
+  header.version = format_version;
+  header.length = sizeof(StoredConfiguration);
+  header.sequence = slot < 0 ? 0 : sequence + 1;
+  header.crc = slotCrc(header, data);
+  
+  region.eraseSector(slotIndex);
+  constexpr size_t total = sizeof(SlotHeader) + sizeof(StoredConfiguration);
+  uint8_t page[FlashRegion::page_size];
+  for (size_t pageStart = 0; pageStart < total; pageStart += FlashRegion::page_size) {
+    std::memset(page, 0xff, sizeof(page));
+    for (size_t index = 0; index < FlashRegion::page_size && pageStart + index < total; ++index) {
+      size_t offset = pageStart + index;
+      page[index] = offset < sizeof(SlotHeader) 
+        ? reinterpret_cast<const uint8_t*>(&header)[offset] 
+        : data[offset - sizeof(SlotHeader)];
+    }
+    region.programPage(slotIndex, pageStart / FlashRegion::page_size, page);
+  }
+  
+  if (validHeader(slotIndex) == nullptr) {
+    return false;
+  }
+  slot = static_cast<int>(slotIndex);
+  sequence = header.sequence;
+  return true;
+}
+
+const ConfigurationStore::SlotHeader* ConfigurationStore::validHeader(uint32_t slotIndex) const {
+  auto sector = region.sector(slotIndex);
+  auto header = reinterpret_cast<const SlotHeader*>(sector);
+  if (header->magic != slot_magic || header->version != format_version ||
+    header->length != sizeof(StoredConfiguration) ||
+    header->crc != slotCrc(*header, sector + sizeof(SlotHeader))) 
+  {
+    return nullptr;
+  }
+  return header;
+}
+
+uint32_t ConfigurationStore::slotCrc(const SlotHeader& header, const uint8_t* data) {
+  auto crc = crc32(reinterpret_cast<const uint8_t*>(&header), offsetof(SlotHeader, crc));
+  return crc32(data, sizeof(StoredConfiguration), crc);
+}
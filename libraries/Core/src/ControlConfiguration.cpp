@@ -0,0 +1,153 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "ControlConfiguration.h"
+
+#include "PowerDevice.h"
+
+#include <algorithm>
+
+using namespace Core;
+
+// Whether a window ends before a second, without touching it.
+static bool endsBefore(const ControlConfiguration::Window& window, uint32_t second) {
+  return window.end + 1 < second;
+}
+
+///
+/// \brief Add a window in which a device is "on".
+/// \description The window is merged with any windows it overlaps or touches, keeping the
+///   windows sorted and apart.
+///
+/// \param startTime The time the window starts.
+/// \param endTime The time the window ends, included in the window. Before the start for 
+///   a window that wraps past midnight, which is added as a window to the end of the day
+///   and a window from its start, or neither.
+/// \return False if there is no room for the window.
+///
+bool ControlConfiguration::addWindow(Time startTime, Time endTime) {
+  uint32_t start = startTime.inSeconds();
+  uint32_t end = endTime.inSeconds();
+  if (start >= seconds_per_day || end >= seconds_per_day) {
+    return false;
+  }
+  if (start == end + 1) {
+    return insertWindow(0, seconds_per_day - 1);
+  }
+  if (start > end) {
+    // The two pieces are apart, so each takes a window of its own unless it merges with
+    // one already there. Both must fit before either is inserted.
+    if (windowCount + needsWindow(start, seconds_per_day - 1) + needsWindow(0, end) > 
+      maximum_windows) 
+    {
+      return false;
+    }
+    insertWindow(start, seconds_per_day - 1);
+    insertWindow(0, end);
+    return true;
+  }
+  return insertWindow(start, end);
+}
+
+bool ControlConfiguration::needsWindow(uint32_t start, uint32_t end) const {
+  auto windowsEnd = &windows[windowCount];
+  auto first = std::lower_bound(&windows[0], windowsEnd, start, endsBefore);
+  return first == windowsEnd || first->start > end + 1;
+}
+
+bool ControlConfiguration::insertWindow(uint32_t start, uint32_t end) {
+  auto windowsEnd = &windows[windowCount];
+  auto first = std::lower_bound(&windows[0], windowsEnd, start, endsBefore);
+  auto last = first;
+  while (last != windowsEnd && last->start <= end + 1) {
+    start = std::min(start, last->start);
+    end = std::max(end, last->end);
+    ++last;
+  }
+  
+  size_t mergedCount = last - first;
+  if (mergedCount == 0) {
+    if (windowCount == maximum_windows) {
+      return false;
+    }
+    std::copy_backward(first, windowsEnd, windowsEnd + 1);
+    ++windowCount;
+  } else {
+    std::copy(last, windowsEnd, first + 1);
+    windowCount -= mergedCount - 1;
+  }
+  
+  *first = {start, end};
+  ++revision;
+  return true;
+}
+
+///
+/// \description The level is only set when it differs, as a dimming device that is on
+///   fades to it.
+///
+void ControlConfiguration::applyOutput(PowerDevice& powerDevice) const {
+  if (powerDevice.getPowerLevel() != powerLevel) {
+    powerDevice.setPowerLevel(powerLevel);
+  }
+  powerDevice.setTransitionDuration(transitionDuration);
+}
+
+void ControlConfiguration::clearWindows() {
+  windowCount = 0;
+  ++revision;
+}
+
+///
+/// \brief Find the state at a second of the day and the span over which it holds.
+/// \description A binary search for the first window that ends at or after the second. The
+///   device is "on" if that window has started, otherwise "off" from the end of the
+///   window before up to the start of this one.
+///
+/// \param secondOfDay The second of the day in the range 0...86399.
+/// \return The span containing the second.
+///
+ControlConfiguration::Span ControlConfiguration::find(uint32_t secondOfDay) const {
+  auto windowsEnd = &windows[windowCount];
+  auto window = std::lower_bound(&windows[0], windowsEnd, secondOfDay,
+    [](const Window& window, uint32_t second) { return window.end < second; });
+  
+  if (window != windowsEnd && window->start <= secondOfDay) {
+    return {true, window->start, window->end + 1};
+  }
+  
+  uint32_t start = window == &windows[0] ? 0 : (window - 1)->end + 1;
+  uint32_t end = window == windowsEnd ? seconds_per_day : window->start;
+  return {false, start, end};
+}
@@ -0,0 +1,126 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "DaylightController.h"
+
+#include <algorithm>
+
+using namespace Core;
+
+DaylightController::DaylightController(PowerDevice& lamp) : lamp(lamp) {}
+
+///
+/// \brief Start or stop regulating.
+/// \description The lamp is left off when regulating starts, and the first update 
+///   switches it on if the daylight falls short, so a window opening in bright daylight
+///   does not flash the lamp. The lamp then rises from off at the ramp rate.
+///
+void DaylightController::setState(State newState) {
+  status = newState;
+  if (newState == on) {
+    output = 0.0f;
+    integral = 0.0f;
+    secondsSinceSwitch = tuning.minimumSwitchSeconds;
+  } else if (lampOn) {
+    switchLamp(false);
+  }
+}
+
+void DaylightController::update(float lux, float seconds) {
+  if (status == off) {
+    return;
+  }
+  onSeconds += seconds;
+  levelSeconds += getOutput() * seconds;
+  secondsSinceSwitch += seconds;
+  
+  float ceiling = std::clamp(powerLevel, 0.0f, 1.0f);
+  float error = (tuning.targetLux - lux) / tuning.lampLux;
+  bool canSwitch = secondsSinceSwitch >= tuning.minimumSwitchSeconds;
+  
+  if (!lampOn) {
+    // With the lamp off the reading is daylight alone, so the error is the level the
+    // lamp needs. The integral starts from it, so regulating starts near the level.
+    if (error >= tuning.switchOnLevel && canSwitch) {
+      integral = std::min(error, ceiling);
+      output = 0.0f;
+      switchLamp(true);
+    }
+    return;
+  }
+  
+  float controlSeconds = std::min(seconds, tuning.maximumUpdateSeconds);
+  float demand = tuning.proportionalGain * error + integral;
+  float step = tuning.rampRate * controlSeconds;
+  float limited = std::clamp(std::clamp(demand, 0.0f, ceiling), output - step, output + step);
+  // Only integrate while the output follows the demand, or the error would drive the 
+  // integral further from it.
+  if ((error > 0.0f && limited >= demand) || (error < 0.0f && limited <= demand)) {
+    integral = std::clamp(integral + tuning.integralGain * error * controlSeconds, 0.0f, 
+                          ceiling);
+  }
+  output = limited;
+  
+  if (output <= tuning.switchOffLevel && canSwitch) {
+    switchLamp(false);
+    return;
+  }
+  // The lamp glides to the new level over the time to the next reading.
+  lamp.setTransitionDuration(static_cast<uint32_t>(controlSeconds * 1000.0f));
+  lamp.setPowerLevel(output);
+}
+
+float DaylightController::getEnergyFraction() const {
+  float ceiling = std::clamp(powerLevel, 0.0f, 1.0f);
+  if (onSeconds == 0.0 || ceiling == 0.0f) {
+    return 0.0f;
+  }
+  return static_cast<float>(levelSeconds / (onSeconds * ceiling));
+}
+
+///
+/// \brief Switch the lamp, fading over the transition duration set for this device.
+///
+void DaylightController::switchLamp(bool on) {
+  lampOn = on;
+  secondsSinceSwitch = 0.0f;
+  ++switchCount;
+  lamp.setTransitionDuration(transitionDuration);
+  if (on) {
+    lamp.setPowerLevel(output);
+    lamp.setState(PowerDevice::on);
+  } else {
+    lamp.setState(PowerDevice::off);
+  }
+}
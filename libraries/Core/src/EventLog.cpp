@@ -0,0 +1,158 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "EventLog.h"
+
+#include "Crc.h"
+
+#include <cstddef>
+#include <cstring>
+
+using namespace Core;
+
+constexpr uint32_t header_magic = 0x4c4f4731; // "LOG1"
+constexpr uint8_t erased_value = 0xff;
+
+void EventLog::init() {
+  clearStaging();
+  
+  bool found = false;
+  for (uint32_t index = 0; index < region.getSectorCount(); ++index) {
+    auto sector = region.sector(index);
+    if (isValidHeader(sector) && (!found || header(sector).sequence > sequence)) {
+      found = true;
+      headSector = index;
+      sequence = header(sector).sequence;
+    }
+  }
+  
+  if (!found) {
+    headSector = region.getSectorCount() - 1;
+    sequence = 0;
+    startNextSector();
+    return;
+  }
+  
+  // Resume after the last slot with anything programmed, which may be a torn record.
+  auto sector = region.sector(headSector);
+  nextSlot = slots_per_sector;
+  while (nextSlot > 1) {
+    auto slot = &sector[(nextSlot - 1) * record_size];
+    bool erased = true;
+    for (uint32_t byte = 0; byte < record_size; ++byte) {
+      erased = erased && slot[byte] == erased_value;
+    }
+    if (!erased) {
+      break;
+    }
+    --nextSlot;
+  }
+  stagedSlot = nextSlot;
+  headStarted = true;
+}
+
+void EventLog::append(EventRecord record) {
+  if (nextSlot == slots_per_sector) {
+    startNextSector();
+  }
+  
+  record.crc = crc16(reinterpret_cast<const uint8_t*>(&record), offsetof(EventRecord, crc));
+  staging[nextSlot % slots_per_page] = record;
+  ++nextSlot;
+  
+  if (nextSlot % slots_per_page == 0) {
+    flush();
+  }
+}
+
+void EventLog::flush() {
+  if (stagedSlot == nextSlot) {
+    return;
+  }
+  
+  // A new sector is erased with its first records, which share a page with its header.
+  if (!headStarted) {
+    region.eraseSector(headSector);
+    headStarted = true;
+  }
+  
+  uint32_t page = stagedSlot / slots_per_page;
+  region.programPage(headSector, page, reinterpret_cast<const uint8_t*>(&staging[0]));
+  
+  clearStaging();
+  stagedSlot = nextSlot;
+}
+
+//
+// Private Interface
+//
+
+bool EventLog::isValidHeader(const uint8_t* sector) {
+  auto& sectorHeader = header(sector);
+  return sectorHeader.magic == header_magic && 
+    sectorHeader.crc == crc16(sector, offsetof(SectorHeader, crc));
+}
+
+bool EventLog::isValidRecord(const EventRecord& record) {
+  auto data = reinterpret_cast<const uint8_t*>(&record);
+  return record.crc == crc16(data, offsetof(EventRecord, crc));
+}
+
+///
+/// \brief Move the head to the next sector around the region.
+///
+/// \details The sector is erased and its header programmed with the first flush, so the
+///   records in it are kept until there are new records to replace them.
+///
+void EventLog::startNextSector() {
+  flush();
+  
+  headSector = (headSector + 1) % region.getSectorCount();
+  ++sequence;
+  nextSlot = 1;
+  stagedSlot = 1;
+  headStarted = false;
+  
+  SectorHeader sectorHeader;
+  memset(&sectorHeader, erased_value, sizeof(sectorHeader));
+  sectorHeader.magic = header_magic;
+  sectorHeader.sequence = sequence;
+  sectorHeader.crc = crc16(reinterpret_cast<const uint8_t*>(&sectorHeader), 
+                           offsetof(SectorHeader, crc));
+  memcpy(&staging[0], &sectorHeader, sizeof(sectorHeader));
+}
+
+void EventLog::clearStaging() {
+  memset(&staging[0], erased_value, sizeof(staging));
+}
@@ -0,0 +1,59 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "FlashRegion.h"
+
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+
+using namespace Core;
+
+static_assert(FlashRegion::sector_size == FLASH_SECTOR_SIZE);
+static_assert(FlashRegion::page_size == FLASH_PAGE_SIZE);
+
+const uint8_t* FlashRegion::sector(uint32_t index) const {
+  return reinterpret_cast<const uint8_t*>(XIP_BASE + offset + index * sector_size);
+}
+
+void FlashRegion::eraseSector(uint32_t index) {
+  auto interrupts = save_and_disable_interrupts();
+  flash_range_erase(offset + index * sector_size, sector_size);
+  restore_interrupts(interrupts);
+}
+
+void FlashRegion::programPage(uint32_t sectorIndex, uint32_t pageIndex, const uint8_t* data) {
+  auto interrupts = save_and_disable_interrupts();
+  flash_range_program(offset + sectorIndex * sector_size + pageIndex * page_size, data, page_size);
+  restore_interrupts(interrupts);
+}
@@ -0,0 +1,199 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "ScheduleCalendar.h"
+
+#include "ControlConfiguration.h"
+#include "SolarCalculator.h"
+
+#include <algorithm>
+
+using namespace Core;
+
+constexpr int32_t seconds_per_day = ControlConfiguration::seconds_per_day;
+
+constexpr uint16_t dayOfYearKey(uint8_t month, uint8_t dayOfMonth) {
+  return static_cast<uint16_t>(month) * 32 + dayOfMonth;
+}
+
+static bool inSeason(const ScheduleRule& rule, Date date) {
+  auto day = dayOfYearKey(date.month, date.dayOfMonth);
+  auto first = dayOfYearKey(rule.firstDay.month, rule.firstDay.dayOfMonth);
+  auto last = dayOfYearKey(rule.lastDay.month, rule.lastDay.dayOfMonth);
+  return first <= last ? day >= first && day <= last : day >= first || day <= last;
+}
+
+static bool isAnchored(const ScheduleRule& rule) {
+  return rule.startAnchor != ScheduleRule::Anchor::clockTime || 
+    rule.endAnchor != ScheduleRule::Anchor::clockTime;
+}
+
+///
+/// \brief A rule's start or end as a second of its day, before 0 or past the day's end
+///   for the days either side.
+///
+static int32_t resolve(ScheduleRule::Anchor anchor, Time time, int16_t offsetMinutes,
+                       const SolarCalculator::SolarTimes* solarTimes) {
+  if (anchor == ScheduleRule::Anchor::clockTime) {
+    return static_cast<int32_t>(time.inSeconds());
+  }
+  int32_t second = anchor == ScheduleRule::Anchor::sunrise 
+    ? solarTimes->sunrise : solarTimes->sunset;
+  // Outside the day for an offset past midnight, on the day before or after.
+  return second + offsetMinutes * 60;
+}
+
+///
+/// \brief Add the part of a window that falls on the compiled date.
+/// \description The window ends at the first end time at or after its start, so it wraps
+///   past midnight when its end is before its start. An anchored window whose end is a
+///   day or more after its start, as from before sunrise to after sunset in polar day,
+///   lasts the whole day from its start instead. So a window lasts less than a day.
+///
+/// \param dayStart The start of the window's day, in seconds from the start of the
+///   compiled date.
+/// \param start The start, as a second of the window's day.
+/// \param end The end, included in the window, as a second of the window's day.
+///
+static void addWindow(ControlConfiguration& configuration, int32_t dayStart, int32_t start,
+                      int32_t end) {
+  if (end - start >= seconds_per_day) {
+    end = start + seconds_per_day - 1;
+  } else {
+    end = start + ((end - start) % seconds_per_day + seconds_per_day) % seconds_per_day;
+  }
+  start = std::max<int32_t>(dayStart + start, 0);
+  end = std::min<int32_t>(dayStart + end, seconds_per_day - 1);
+  if (start <= end) {
+    configuration.addWindow(Time::fromSeconds(start), Time::fromSeconds(end));
+  }
+}
+
+static bool isOffsetInRange(int16_t offsetMinutes) {
+  return offsetMinutes >= -ScheduleRule::maximum_offset_minutes && 
+    offsetMinutes <= ScheduleRule::maximum_offset_minutes;
+}
+
+bool ScheduleCalendar::addRule(const ScheduleRule& rule) {
+  if (ruleCount == maximum_rules || !isOffsetInRange(rule.startOffsetMinutes) || 
+    !isOffsetInRange(rule.endOffsetMinutes)) 
+  {
+    return false;
+  }
+  rules[ruleCount++] = rule;
+  return true;
+}
+
+bool ScheduleCalendar::addException(const ScheduleException& exception) {
+  if (exceptionCount == maximum_exceptions) {
+    return false;
+  }
+  exceptions[exceptionCount++] = exception;
+  return true;
+}
+
+void ScheduleCalendar::clear() {
+  ruleCount = 0;
+  exceptionCount = 0;
+}
+
+///
+/// \brief Compile the windows for a date into a configuration.
+/// \description Windows last less than a day, and start up to half a day either side of
+///   their own day when anchored to sunrise or sunset. So those on a date are the parts
+///   that fall on it of the windows of the two days before, the date and the day after.
+///   The configuration's windows are replaced, and merged where they overlap.
+///
+/// \param date The date to compile. Its day of the week is taken from the date.
+/// \param configuration The configuration to set the windows of.
+///
+void ScheduleCalendar::compile(Date date, ControlConfiguration& configuration) const {
+  configuration.clearWindows();
+  int32_t days = static_cast<int32_t>(date.toDays());
+  for (int32_t day = -2; day <= 1; ++day) {
+    if (days + day >= 0) {
+      addWindows(Date::fromDays(static_cast<uint32_t>(days + day)), day * seconds_per_day, 
+                 configuration);
+    }
+  }
+}
+
+///
+/// \brief Add the windows that start on a day to a configuration.
+/// \description Any exceptions for the day give its windows, otherwise the rules for its
+///   day of the week and season do. Sunrise and sunset are calculated for the day if a 
+///   rule is anchored to them.
+///
+/// \param day The day the windows start on.
+/// \param dayStart The start of the day, in seconds from the start of the compiled date.
+/// \param configuration The configuration to add the windows to.
+///
+void ScheduleCalendar::addWindows(Date day, int32_t dayStart, 
+                                  ControlConfiguration& configuration) const 
+{
+  bool excepted = false;
+  for (size_t index = 0; index < exceptionCount; ++index) {
+    auto& exception = exceptions[index];
+    if (exception.date == day) {
+      excepted = true;
+      if (!exception.off) {
+        addWindow(configuration, dayStart, exception.startTime.inSeconds(), 
+                  exception.endTime.inSeconds());
+      }
+    }
+  }
+  if (excepted) {
+    return;
+  }
+  
+  uint8_t dayFlag = 1 << (day.derivedDayOfWeek() - 1);
+  const SolarCalculator::SolarTimes* solarTimes = nullptr;
+  for (size_t index = 0; index < ruleCount; ++index) {
+    auto& rule = rules[index];
+    if (!(rule.daysOfWeek & dayFlag) || !inSeason(rule, day)) {
+      continue;
+    }
+    if (isAnchored(rule)) {
+      if (solarCalculator == nullptr) {
+        continue;
+      }
+      if (solarTimes == nullptr) {
+        solarTimes = &solarCalculator->calculate(day);
+      }
+    }
+    addWindow(configuration, dayStart,
+      resolve(rule.startAnchor, rule.startTime, rule.startOffsetMinutes, solarTimes),
+      resolve(rule.endAnchor, rule.endTime, rule.endOffsetMinutes, solarTimes));
+  }
+}
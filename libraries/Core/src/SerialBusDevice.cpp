@@ -57,6 +57,7 @@ void SerialBusDevice::writeRegisters(uint8_t startAddress, uint8_t* source, size
   buffer[0] = startAddress;
   memcpy(&buffer[1], source, length);
   serialBus.write(deviceAddress, &buffer[0], length + 1);
+  delete[] buffer;
 }
 
 void SerialBusDevice::readRegisters(uint8_t startAddress, uint8_t* destination, size_t length) {
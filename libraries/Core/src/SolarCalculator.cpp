@@ -0,0 +1,139 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "SolarCalculator.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Core;
+
+constexpr float pi = 3.14159265f;
+constexpr float radiansPerDegree = pi / 180.0f;
+constexpr float minutesPerDay = 24 * 60;
+// The sun's zenith angle at sunrise and sunset, for refraction and the sun's radius.
+constexpr float horizonZenith = 90.833f * radiansPerDegree;
+
+static float wrapDegrees(float degrees) {
+  degrees = std::fmod(degrees, 360.0f);
+  return degrees < 0 ? degrees + 360.0f : degrees;
+}
+
+static uint32_t toSecondOfDay(float minutes) {
+  auto seconds = std::lround(std::clamp(minutes, 0.0f, minutesPerDay) * 60.0f);
+  return std::min<uint32_t>(seconds, 24 * 60 * 60 - 1);
+}
+
+///
+/// \brief The minutes of the day of sunrise or sunset in UTC.
+/// \description The sun's declination and the equation of time are from the Astronomical
+///   Almanac's low precision solar coordinates, good to about 0.01 degrees.
+///
+/// \param days Days from the J2000 epoch at the time of the event.
+/// \param latitude The latitude in degrees.
+/// \param longitude The longitude in degrees.
+/// \param hourAngleSign -1 for sunrise, 1 for sunset.
+/// \param cosHourAngle Set to the cosine of the hour angle, outside -1...1 when the sun
+///   does not cross the horizon, in which case solar noon is returned.
+/// \return The minutes from midnight UTC.
+///
+static float solarEvent(float days, float latitude, float longitude, float hourAngleSign,
+                        float& cosHourAngle) {
+  float meanLongitude = wrapDegrees(280.460f + 0.9856474f * days);
+  float meanAnomaly = wrapDegrees(357.528f + 0.9856003f * days) * radiansPerDegree;
+  float eclipticLongitude = (meanLongitude + 1.915f * std::sin(meanAnomaly) 
+    + 0.020f * std::sin(2 * meanAnomaly)) * radiansPerDegree;
+  float obliquity = (23.439f - 0.0000004f * days) * radiansPerDegree;
+  
+  float declination = std::asin(std::sin(obliquity) * std::sin(eclipticLongitude));
+  float rightAscension = std::atan2(std::cos(obliquity) * std::sin(eclipticLongitude),
+                                    std::cos(eclipticLongitude)) / radiansPerDegree;
+  // The equation of time in minutes, the sun moving 4 minutes a degree.
+  float equationOfTime = 4.0f * (wrapDegrees(meanLongitude - rightAscension + 180.0f) - 180.0f);
+  
+  float latitudeRadians = latitude * radiansPerDegree;
+  cosHourAngle = std::cos(horizonZenith) / (std::cos(latitudeRadians) * std::cos(declination)) 
+    - std::tan(latitudeRadians) * std::tan(declination);
+  
+  float solarNoon = 720.0f - 4.0f * longitude - equationOfTime;
+  if (cosHourAngle >= 1.0f || cosHourAngle <= -1.0f) {
+    return solarNoon;
+  }
+  float hourAngle = std::acos(cosHourAngle) / radiansPerDegree;
+  return solarNoon + hourAngleSign * 4.0f * hourAngle;
+}
+
+///
+/// \brief Calculate sunrise and sunset for a date.
+/// \description Each event is first estimated with the sun's position at noon, then
+///   calculated again at the estimated time, as the declination changes by up to half
+///   a degree a day. The times are local to the clock's UTC offset, and clamped to the day.
+///
+/// \param date The date.
+/// \return The sunrise and sunset, cached with those of the last few dates.
+///
+const SolarCalculator::SolarTimes& SolarCalculator::calculate(Date date) {
+  for (auto& entry : cache) {
+    if (entry.date == date) {
+      return entry.times;
+    }
+  }
+  auto& entry = cache[nextCacheIndex];
+  nextCacheIndex = (nextCacheIndex + 1) % cache_size;
+  
+  // Days from the epoch to midnight UTC of the local date.
+  float midnight = date.toDays() - 0.5f;
+  float events[2];
+  float cosHourAngle = 0;
+  for (int index = 0; index < 2; ++index) {
+    float sign = index == 0 ? -1.0f : 1.0f;
+    float estimate = solarEvent(midnight + 0.5f, latitude, longitude, sign, cosHourAngle);
+    float days = midnight + estimate / minutesPerDay;
+    events[index] = solarEvent(days, latitude, longitude, sign, cosHourAngle) + utcOffsetMinutes;
+  }
+  
+  if (cosHourAngle >= 1.0f) {
+    entry.times.sunrise = toSecondOfDay((events[0] + events[1]) / 2);
+    entry.times.sunset = entry.times.sunrise;
+  } else if (cosHourAngle <= -1.0f) {
+    entry.times.sunrise = 0;
+    entry.times.sunset = toSecondOfDay(minutesPerDay);
+  } else {
+    entry.times.sunrise = toSecondOfDay(events[0]);
+    entry.times.sunset = toSecondOfDay(events[1]);
+  }
+  
+  entry.date = date;
+  return entry.times;
+}
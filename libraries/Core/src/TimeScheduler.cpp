@@ -36,9 +36,11 @@
 
 #include "TimeScheduler.h"
 
+#include "AlarmClockDevice.h"
 #include "ControlConfiguration.h"
 #include "PowerDevice.h"
 #include "RealTimeClockDevice.h"
+#include "ScheduleCalendar.h"
 
 using namespace Core;
 
@@ -48,21 +50,86 @@ TimeScheduler::TimeScheduler(PowerDevice& powerDevice,
     : powerDevice(powerDevice), timeDevice(timeDevice),
       configuration(configuration) 
 {
-  powerDevice.setPowerLevel(configuration.powerLevel);
+  configuration.applyOutput(powerDevice);
 }
 
+TimeScheduler::TimeScheduler(PowerDevice& powerDevice, 
+                             RealTimeClockDevice& timeDevice,
+                             ControlConfiguration& configuration,
+                             AlarmClockDevice& alarmDevice)
+    : TimeScheduler(powerDevice, timeDevice, configuration)
+{
+  this->alarmDevice = &alarmDevice;
+}
+
+void TimeScheduler::setCalendar(ScheduleCalendar& calendar) {
+  this->calendar = &calendar;
+  reset();
+}
+
+void TimeScheduler::reset() {
+  compiledDate = {0, 0, 0, 0};
+  span = {false, 1, 0};
+}
+
+void TimeScheduler::setOverride(bool on) {
+  overridden = true;
+  overrideOn = on;
+}
+
+///
+/// \brief Switch the power device to the scheduled state for the current time.
+/// \description The configuration is only searched when the time leaves the span found
+///   by the last search, at the next transition or when the day wraps, or when the
+///   configuration has changed. With a calendar, the date is read then, and the calendar
+///   compiled when the date has changed. Spans end at midnight at the latest, so this 
+///   is once a day. With an alarm device, the alarm is then armed for the
+///   span's end, midnight when no transition is left in the day. An override is kept
+///   until a search finds a different span, or a new day. When the configuration has
+///   changed, the power device takes its power level and transition duration first.
+///
 void TimeScheduler::update() {
-  auto currentTime = timeDevice.readTime();
-  if (powerDevice.getStatus() == PowerDevice::off && 
-    currentTime >= configuration.startTime &&
-    currentTime <= configuration.endTime) 
-  {
-    powerDevice.setState(PowerDevice::on);
-  } else if (powerDevice.getStatus() == PowerDevice::on && 
-    (currentTime < configuration.startTime ||
-    currentTime > configuration.endTime)) 
+  auto previousSecond = currentSecond;
+  currentSecond = timeDevice.readTime().inSeconds();
+  // A time before the last is a new day. The same time is too when the date has changed, 
+  // as when a span covering the whole day is slept through from one midnight to the 
+  // next, and otherwise an update repeated within the second.
+  bool newDay = currentSecond < previousSecond;
+  if (currentSecond == previousSecond && calendar != nullptr) {
+    newDay = timeDevice.readDate() != compiledDate;
+  }
+  if (newDay || currentSecond < span.start || currentSecond >= span.end || 
+    configuration.getRevision() != revision) 
   {
-    powerDevice.setState(PowerDevice::off);
+    if (calendar != nullptr) {
+      // The time is read again with the date, so they agree across midnight.
+      auto clockDatum = timeDevice.read();
+      auto date = clockDatum.date;
+      currentSecond = clockDatum.time.inSeconds();
+      if (date != compiledDate) {
+        calendar->compile(date, configuration);
+        compiledDate = date;
+      }
+    }
+    if (configuration.getRevision() != revision) {
+      configuration.applyOutput(powerDevice);
+    }
+    auto nextSpan = configuration.find(currentSecond);
+    if (newDay || configuration.getRevision() != revision || nextSpan.on != span.on || 
+      nextSpan.start != span.start || nextSpan.end != span.end) 
+    {
+      overridden = false;
+    }
+    span = nextSpan;
+    revision = configuration.getRevision();
+    if (alarmDevice != nullptr) {
+      alarmDevice->armAlarm(Time::fromSeconds(span.end));
+    }
+  }
+  
+  auto on = overridden ? overrideOn : span.on;
+  auto state = on ? PowerDevice::on : PowerDevice::off;
+  if (powerDevice.getStatus() != state) {
+    powerDevice.setState(state);
   }
 }
- 
\ No newline at end of file
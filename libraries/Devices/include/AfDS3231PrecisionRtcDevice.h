@@ -36,6 +36,7 @@
 
 #pragma once
 
+#include "AlarmClockDevice.h"
 #include "Clock.h"
 #include "Device.h"
 #include "RealTimeClockDevice.h"
@@ -45,10 +46,25 @@
 namespace Device {
 
 class AfDS3231PrecisionRtcDevice final : 
-  public Core::RealTimeClockDevice, Core::Device,
+  public Core::RealTimeClockDevice, public Core::AlarmClockDevice, Core::Device,
   private Core::SerialBusDevice 
 {
 public:
+  ///
+  /// \brief Match modes for alarm 1, which matches to the second.
+  /// \description The alarm triggers when the listed fields match the clock, every second
+  ///   when none are listed.
+  ///
+  enum class Alarm1Mode { everySecond, seconds, minutesSeconds, hoursMinutesSeconds, dateTime, dayTime };
+  ///
+  /// \brief Match modes for alarm 2, which matches to the minute at 00 seconds.
+  ///
+  enum class Alarm2Mode { everyMinute, minutes, hoursMinutes, dateTime, dayTime };
+  ///
+  /// \brief Flags for the alarms, matching their interrupt enable and status bits.
+  ///
+  enum AlarmFlag : uint8_t { alarm1Flag = 0x01, alarm2Flag = 0x02 };
+  
   AfDS3231PrecisionRtcDevice(Core::SerialBus &);
   ~AfDS3231PrecisionRtcDevice() = default;
 
@@ -58,7 +74,21 @@ public:
   Core::Date readDate() override;
   Core::ClockDatum read() override;
   
+  ///
+  /// \description The day of the week is set from the date.
+  ///
   void write(Core::ClockDatum clockDatum) override;
+  
+  void setAlarm1(Alarm1Mode mode, Core::ClockDatum clockDatum);
+  void setAlarm2(Alarm2Mode mode, Core::ClockDatum clockDatum);
+  void enableAlarmInterrupts(uint8_t alarmFlags);
+  void disableAlarmInterrupts(uint8_t alarmFlags);
+  uint8_t readAlarmFlags();
+  void clearAlarmFlags(uint8_t alarmFlags);
+  
+  void armAlarm(Core::Time time) override;
+  void disarmAlarm() override;
+  bool clearAlarm() override;
 
 private:
   struct TimeBuffer {
@@ -0,0 +1,85 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#pragma once
+
+#include "Device.h"
+#include "PowerDevice.h"
+
+#include "pico/time.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Device {
+
+///
+/// \brief A dimmable power device driven by a hardware PWM slice.
+/// \description Levels are steps of perceived lightness, mapped to duty cycles through
+///   the CIE 1931 lightness curve, so a fade looks even to the eye. Fades are advanced by
+///   a repeating timer interrupt, one step per interrupt, without the main loop. The PWM
+///   slice latches a new level at the end of its period, so a step never cuts a period
+///   short, and the 16 bit period runs at about 1.9 kHz with the default system clock.
+///
+class PwmPowerDevice final : public Core::PowerDevice, Core::Device {
+public:
+  static constexpr size_t level_steps = 256;
+  /// \brief The top of the PWM counter, and the duty cycle of full on.
+  static constexpr uint16_t pwm_wrap = 0xffff;
+  
+  PwmPowerDevice(unsigned int gpio);
+  PwmPowerDevice(const PwmPowerDevice&) = delete;
+  ~PwmPowerDevice();
+  
+  void init() override;
+  
+  void setState(State) override;
+  void setPowerLevel(float level) override;
+  
+  bool isFading() const { return fading; }
+  
+private:
+  unsigned int gpio;
+  repeating_timer_t timer;
+  volatile uint16_t currentStep = 0;
+  volatile uint16_t targetStep = 0;
+  volatile bool fading = false;
+  
+  void fadeTo(uint16_t step);
+  void setStep(uint16_t step);
+  void stopFade();
+  static bool advanceFade(repeating_timer_t* timer);
+}; // class PwmPowerDevice
+
+}; // namespace Device
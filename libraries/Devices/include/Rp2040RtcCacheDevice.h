@@ -0,0 +1,144 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#pragma once
+
+#include "Clock.h"
+#include "Device.h"
+#include "RealTimeClockDevice.h"
+
+#include "pico/time.h"
+
+#include <cstdint>
+
+namespace Device {
+
+///
+/// \brief The RP2040's on-chip RTC, kept in step with a reference clock.
+/// \description Reads are served from the on-chip RTC, without a bus transfer, and the
+///   RTC is set from the reference at init and again at each sync interval. A sync 
+///   waits for the reference's seconds to change, so the RTC ticks within a couple of
+///   milliseconds of it. At init it blocks for up to two seconds; after that a sync is
+///   spread over polls, each taking at most one read of the reference, and reads are
+///   served from the RTC meanwhile. The time between syncs is also measured against the
+///   system timer, which runs from the same crystal as the RTC, giving the drift the 
+///   syncs correct.
+///
+class Rp2040RtcCacheDevice final : public Core::RealTimeClockDevice, Core::Device {
+public:
+  static constexpr uint32_t default_sync_interval_seconds = 60 * 60;
+  
+  Rp2040RtcCacheDevice(Core::RealTimeClockDevice& referenceDevice);
+  Rp2040RtcCacheDevice(const Rp2040RtcCacheDevice&) = delete;
+  ~Rp2040RtcCacheDevice() = default;
+  
+  void init() override;
+  
+  Core::Time readTime() override;
+  Core::Date readDate() override;
+  Core::ClockDatum read() override;
+  
+  ///
+  /// \description Writes the reference and sets the RTC to match.
+  ///
+  void write(Core::ClockDatum clockDatum) override;
+  
+  void setSyncInterval(uint32_t seconds) { syncInterval = seconds; }
+  ///
+  /// \brief Set the RTC from the reference, measuring the drift since the last sync.
+  /// \description Blocks for up to two seconds, finishing a sync in progress.
+  ///
+  void sync();
+  ///
+  /// \brief Take the next step of a sync, starting one when the sync interval has passed.
+  /// \description Never blocks, and reads the reference at most once. Each read polls,
+  ///   but a sync is only as close as the polls are frequent, so a caller should poll 
+  ///   every millisecond or so while it is idle.
+  ///
+  void poll();
+  bool isSyncing() const { return syncState != SyncState::idle; }
+  
+  ///
+  /// \brief The RTC's drift over the last sync interval in microseconds.
+  /// \description Positive when the RTC ran fast of the reference.
+  ///
+  int64_t getDrift() const { return drift; }
+  ///
+  /// \brief The RTC's drift over the last sync interval in parts per million.
+  ///
+  float getDriftPpm() const;
+  uint32_t getSyncCount() const { return syncCount; }
+  ///
+  /// \brief The reads served from the RTC, each a bus transfer saved.
+  ///
+  uint32_t getLocalReadCount() const { return localReadCount; }
+  ///
+  /// \brief The reads made of the reference, to set the RTC and find its seconds.
+  ///
+  uint32_t getReferenceReadCount() const { return referenceReadCount; }
+  
+private:
+  ///
+  /// \brief The steps of a sync. The reference's seconds are polled coarsely to find
+  ///   when they change, then finely from just before the next change.
+  ///
+  enum class SyncState : uint8_t { idle, coarse, waiting, fine };
+  
+  Core::RealTimeClockDevice& referenceDevice;
+  uint32_t syncInterval = default_sync_interval_seconds;
+  absolute_time_t nextSyncTime;
+  SyncState syncState = SyncState::idle;
+  // The next read of the reference in a sync, when its polling of the step gives up, and
+  // the reference's time at the last read and as the step started.
+  absolute_time_t pollTime;
+  absolute_time_t pollTimeout;
+  Core::ClockDatum pollClockDatum = {{0, 0, 0}, {0, 0, 0, 0}};
+  uint8_t pollSeconds = 0;
+  // The time and the reference's time at the last sync.
+  absolute_time_t syncTime;
+  Core::EpochSeconds syncEpochSeconds = {0};
+  uint32_t syncCount = 0;
+  int64_t drift = 0;
+  int64_t driftInterval = 0;
+  uint32_t localReadCount = 0;
+  uint32_t referenceReadCount = 0;
+  
+  void startSync();
+  void pollReference(uint32_t pollMs);
+  void finishSync(absolute_time_t tickTime);
+  Core::ClockDatum readLocal();
+  void setLocal(Core::ClockDatum clockDatum);
+}; // class Rp2040RtcCacheDevice
+
+}; // namespace Device
@@ -49,6 +49,23 @@ constexpr uint8_t serialBusAddress = 0x68;
 
 constexpr uint8_t secondsRegisterAddress = 0x00;
 constexpr uint8_t dayOfWeekRegisterAddress = 0x03;
+constexpr uint8_t alarm1RegisterAddress = 0x07;
+constexpr uint8_t alarm2RegisterAddress = 0x0b;
+constexpr uint8_t controlRegisterAddress = 0x0e;
+constexpr uint8_t statusRegisterAddress = 0x0f;
+
+// Alarm register bits. The mask bit in each of an alarm's registers leaves that field 
+// out of the match, and the day bit matches the day of the week instead of the date.
+constexpr uint8_t alarmMaskBit = 0x80;
+constexpr uint8_t alarmDayBit = 0x40;
+// Control register bits. With the interrupt control bit set the INT/SQW pin signals
+// alarms instead of a square wave.
+constexpr uint8_t interruptControlBit = 0x04;
+constexpr uint8_t alarmFlagsMask = 0x03;
+
+// The mask bits of each alarm mode, a bit for each alarm register from the first.
+constexpr uint8_t alarm1Masks[] = {0b1111, 0b1110, 0b1100, 0b1000, 0b0000, 0b0000};
+constexpr uint8_t alarm2Masks[] = {0b111, 0b110, 0b100, 0b000, 0b000};
 
 constexpr uint8_t convertFromBcd(uint8_t value, uint8_t decimalMask) {
   return ((decimalMask & value) >> 4) * 10 + (0x0f & value);
@@ -64,6 +81,15 @@ constexpr uint8_t dayOfMonthDecimalMask   = 0x30;
 constexpr uint8_t monthDecimalMask        = 0x10;
 constexpr uint8_t yearDecimalMask         = 0xf0;
 
+constexpr uint8_t alarmMask(uint8_t masks, int index) {
+  return (masks >> index) & 1 ? alarmMaskBit : 0;
+}
+
+constexpr uint8_t alarmDayOrDate(bool matchDay, Date date) {
+  return matchDay ? alarmDayBit | date.dayOfWeek 
+    : convertToBcd(date.dayOfMonth, dayOfMonthDecimalMask);
+}
+
 AfDS3231PrecisionRtcDevice::AfDS3231PrecisionRtcDevice(SerialBus &bus)
     : SerialBusDevice(bus, serialBusAddress) {}
 
@@ -116,7 +142,7 @@ void AfDS3231PrecisionRtcDevice::write(ClockDatum clockDatum) {
   buffer.clockDatum.time.seconds = convertToBcd(clockDatum.time.seconds, secondsDecimalMask);
   buffer.clockDatum.time.minutes = convertToBcd(clockDatum.time.minutes, minutesDecimalMask);
   buffer.clockDatum.time.hour = convertToBcd(clockDatum.time.hour, hourDecimalMask);
-  buffer.clockDatum.date.dayOfWeek = clockDatum.date.dayOfWeek;
+  buffer.clockDatum.date.dayOfWeek = clockDatum.date.derivedDayOfWeek();
   buffer.clockDatum.date.dayOfMonth = convertToBcd(clockDatum.date.dayOfMonth, dayOfMonthDecimalMask);
   buffer.clockDatum.date.month = convertToBcd(clockDatum.date.month, monthDecimalMask);
   buffer.clockDatum.date.year = convertToBcd(clockDatum.date.year, yearDecimalMask);
@@ -124,3 +150,95 @@ void AfDS3231PrecisionRtcDevice::write(ClockDatum clockDatum) {
   writeRegisters(secondsRegisterAddress, &buffer.data[0], 7);
 }
 
+
+///
+/// \brief Set alarm 1's registers.
+/// \description The alarm's interrupt is enabled separately, and its flag is left as is.
+///
+/// \param mode The fields to match.
+/// \param clockDatum The time, and the date or day of the week, to match.
+///
+void AfDS3231PrecisionRtcDevice::setAlarm1(Alarm1Mode mode, ClockDatum clockDatum) {
+  auto masks = alarm1Masks[static_cast<int>(mode)];
+  uint8_t buffer[] = {
+    static_cast<uint8_t>(convertToBcd(clockDatum.time.seconds, secondsDecimalMask) | alarmMask(masks, 0)),
+    static_cast<uint8_t>(convertToBcd(clockDatum.time.minutes, minutesDecimalMask) | alarmMask(masks, 1)),
+    static_cast<uint8_t>(convertToBcd(clockDatum.time.hour, hourDecimalMask) | alarmMask(masks, 2)),
+    static_cast<uint8_t>(alarmDayOrDate(mode == Alarm1Mode::dayTime, clockDatum.date) | alarmMask(masks, 3))
+  };
+  writeRegisters(alarm1RegisterAddress, &buffer[0], sizeof(buffer));
+}
+
+///
+/// \brief Set alarm 2's registers.
+/// \description The alarm's interrupt is enabled separately, and its flag is left as is.
+///
+/// \param mode The fields to match.
+/// \param clockDatum The time, without seconds, and the date or day of the week to match.
+///
+void AfDS3231PrecisionRtcDevice::setAlarm2(Alarm2Mode mode, ClockDatum clockDatum) {
+  auto masks = alarm2Masks[static_cast<int>(mode)];
+  uint8_t buffer[] = {
+    static_cast<uint8_t>(convertToBcd(clockDatum.time.minutes, minutesDecimalMask) | alarmMask(masks, 0)),
+    static_cast<uint8_t>(convertToBcd(clockDatum.time.hour, hourDecimalMask) | alarmMask(masks, 1)),
+    static_cast<uint8_t>(alarmDayOrDate(mode == Alarm2Mode::dayTime, clockDatum.date) | alarmMask(masks, 2))
+  };
+  writeRegisters(alarm2RegisterAddress, &buffer[0], sizeof(buffer));
+}
+
+///
+/// \brief Enable the interrupts of alarms.
+/// \description Switches the INT/SQW pin to alarm interrupts, and leaves the other
+///   alarm's interrupt as is.
+///
+/// \param alarmFlags The alarms to enable.
+///
+void AfDS3231PrecisionRtcDevice::enableAlarmInterrupts(uint8_t alarmFlags) {
+  auto control = readRegister(controlRegisterAddress);
+  writeRegister(controlRegisterAddress, 
+                control | interruptControlBit | (alarmFlags & alarmFlagsMask));
+}
+
+void AfDS3231PrecisionRtcDevice::disableAlarmInterrupts(uint8_t alarmFlags) {
+  auto control = readRegister(controlRegisterAddress);
+  writeRegister(controlRegisterAddress, control & ~(alarmFlags & alarmFlagsMask));
+}
+
+///
+/// \description The flags are set when an alarm matches, whether or not its interrupt is
+///   enabled, and hold the INT/SQW pin low until cleared.
+///
+/// \return The flags of the alarms that have triggered.
+///
+uint8_t AfDS3231PrecisionRtcDevice::readAlarmFlags() {
+  return readRegister(statusRegisterAddress) & alarmFlagsMask;
+}
+
+void AfDS3231PrecisionRtcDevice::clearAlarmFlags(uint8_t alarmFlags) {
+  auto status = readRegister(statusRegisterAddress);
+  writeRegister(statusRegisterAddress, status & ~(alarmFlags & alarmFlagsMask));
+}
+
+///
+/// \brief Arm a daily alarm with alarm 1.
+/// \description A flag left from an earlier alarm is cleared before the interrupt is
+///   enabled, so the INT/SQW pin is released until the new time.
+///
+void AfDS3231PrecisionRtcDevice::armAlarm(Time time) {
+  setAlarm1(Alarm1Mode::hoursMinutesSeconds, ClockDatum(time, Date()));
+  clearAlarmFlags(alarm1Flag);
+  enableAlarmInterrupts(alarm1Flag);
+}
+
+void AfDS3231PrecisionRtcDevice::disarmAlarm() {
+  disableAlarmInterrupts(alarm1Flag);
+  clearAlarmFlags(alarm1Flag);
+}
+
+bool AfDS3231PrecisionRtcDevice::clearAlarm() {
+  bool triggered = readAlarmFlags() & alarm1Flag;
+  if (triggered) {
+    clearAlarmFlags(alarm1Flag);
+  }
+  return triggered;
+}
@@ -0,0 +1,165 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "PwmPowerDevice.h"
+
+#include "hardware/gpio.h"
+#include "hardware/pwm.h"
+
+#include <algorithm>
+#include <array>
+
+using namespace Device;
+
+///
+/// \brief The duty cycle for each step of perceived lightness.
+/// \description The CIE 1931 lightness L* of step i is 100 i / (steps - 1), and the 
+///   relative luminance Y is ((L* + 16) / 116)^3, or L* / 903.3 near black.
+///
+static constexpr std::array<uint16_t, PwmPowerDevice::level_steps> makeLightnessTable() {
+  std::array<uint16_t, PwmPowerDevice::level_steps> table;
+  for (size_t step = 0; step < PwmPowerDevice::level_steps; ++step) {
+    double lightness = 100.0 * step / (PwmPowerDevice::level_steps - 1);
+    double scaled = (lightness + 16.0) / 116.0;
+    double luminance = lightness <= 8.0 ? lightness / 903.3 : scaled * scaled * scaled;
+    table[step] = static_cast<uint16_t>(luminance * PwmPowerDevice::pwm_wrap + 0.5);
+  }
+  return table;
+}
+
+constexpr auto lightnessTable = makeLightnessTable();
+
+static constexpr bool isIncreasing(
+  const std::array<uint16_t, PwmPowerDevice::level_steps>& table) 
+{
+  for (size_t step = 1; step < table.size(); ++step) {
+    if (table[step] <= table[step - 1]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(lightnessTable[0] == 0 && 
+              lightnessTable[PwmPowerDevice::level_steps - 1] == PwmPowerDevice::pwm_wrap);
+static_assert(isIncreasing(lightnessTable), "Each lightness step must raise the duty cycle.");
+
+PwmPowerDevice::PwmPowerDevice(unsigned int gpio) : gpio(gpio) {}
+
+PwmPowerDevice::~PwmPowerDevice() {
+  stopFade();
+}
+
+void PwmPowerDevice::init() {
+  gpio_set_function(gpio, GPIO_FUNC_PWM);
+  auto config = pwm_get_default_config();
+  pwm_config_set_wrap(&config, pwm_wrap);
+  pwm_config_set_clkdiv(&config, 1.0f);
+  pwm_set_gpio_level(gpio, 0);
+  pwm_init(pwm_gpio_to_slice_num(gpio), &config, true);
+}
+
+void PwmPowerDevice::setState(State newState) {
+  status = newState;
+  uint16_t step = 0;
+  if (newState == on) {
+    step = static_cast<uint16_t>(std::clamp(powerLevel, 0.0f, 1.0f) * (level_steps - 1) + 0.5f);
+  }
+  fadeTo(step);
+}
+
+void PwmPowerDevice::setPowerLevel(float level) {
+  powerLevel = level;
+  if (status == on) {
+    setState(on);
+  }
+}
+
+///
+/// \brief Fade from the current step to another over the transition duration.
+/// \description The timer's interval is the duration over the number of steps, so a 
+///   fade's steps are evenly spaced in time and in perceived lightness. A fade in 
+///   progress is replaced, continuing from the step it reached. Without a free alarm
+///   for the timer the step is set straight away.
+///
+void PwmPowerDevice::fadeTo(uint16_t step) {
+  stopFade();
+  targetStep = step;
+  uint32_t stepCount = step > currentStep ? step - currentStep : currentStep - step;
+  if (stepCount == 0 || transitionDuration == 0) {
+    setStep(step);
+    return;
+  }
+  
+  int64_t interval = static_cast<int64_t>(transitionDuration) * 1000 / stepCount;
+  // Marked before the timer is added, as its interrupt can end the fade before the call
+  // returns. A negative interval times each step from the start of the last, so they
+  // don't drift.
+  fading = true;
+  if (!add_repeating_timer_us(-std::max<int64_t>(interval, 1), advanceFade, this, &timer)) {
+    fading = false;
+    setStep(step);
+  }
+}
+
+void PwmPowerDevice::setStep(uint16_t step) {
+  currentStep = step;
+  pwm_set_gpio_level(gpio, lightnessTable[step]);
+}
+
+void PwmPowerDevice::stopFade() {
+  if (fading) {
+    cancel_repeating_timer(&timer);
+    fading = false;
+  }
+}
+
+///
+/// \brief Timer interrupt handler advancing a fade by a step.
+///
+/// \return False to stop the timer once the target is reached.
+///
+bool PwmPowerDevice::advanceFade(repeating_timer_t* timer) {
+  auto device = static_cast<PwmPowerDevice*>(timer->user_data);
+  uint16_t step = device->currentStep;
+  step += device->targetStep > step ? 1 : -1;
+  device->currentStep = step;
+  pwm_set_gpio_level(device->gpio, lightnessTable[step]);
+  
+  if (step == device->targetStep) {
+    device->fading = false;
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,219 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "Rp2040RtcCacheDevice.h"
+
+#include "hardware/rtc.h"
+#include "pico/stdlib.h"
+
+using namespace Core;
+using namespace Device;
+
+// The periods of the coarse and fine polls of a sync, and how long before the expected
+// change of the reference's seconds the fine polls start.
+constexpr uint32_t coarsePollMs = 50;
+constexpr uint32_t finePollMs = 1;
+constexpr uint32_t finePollLeadMs = 5;
+// Each step's polling gives up after a little over a second, in case the reference has
+// stopped.
+constexpr uint32_t tickTimeoutMs = 1100;
+// A read of the RTC may not show a new setting for up to three cycles of its 46875 Hz clock.
+constexpr uint64_t rtcSettleUs = 64;
+// The RTC counts years in full, the reference from 2000.
+constexpr int16_t rtcYearBase = 2000;
+
+Rp2040RtcCacheDevice::Rp2040RtcCacheDevice(RealTimeClockDevice& referenceDevice)
+    : referenceDevice(referenceDevice) {}
+
+void Rp2040RtcCacheDevice::init() {
+  rtc_init();
+  sync();
+}
+
+Time Rp2040RtcCacheDevice::readTime() {
+  return readLocal().time;
+}
+
+Date Rp2040RtcCacheDevice::readDate() {
+  return readLocal().date;
+}
+
+ClockDatum Rp2040RtcCacheDevice::read() {
+  return readLocal();
+}
+
+void Rp2040RtcCacheDevice::write(ClockDatum clockDatum) {
+  referenceDevice.write(clockDatum);
+  // Writing the reference's seconds restarts its second, so the RTC is set straight away,
+  // and the drift measured again from here.
+  setLocal(clockDatum);
+  syncTime = get_absolute_time();
+  syncEpochSeconds = EpochSeconds::fromClockDatum(clockDatum);
+  driftInterval = 0;
+  nextSyncTime = make_timeout_time_ms(syncInterval * 1000);
+  // A sync in progress would set the RTC back to the reference's time before the write.
+  syncState = SyncState::idle;
+}
+
+void Rp2040RtcCacheDevice::sync() {
+  if (syncState == SyncState::idle) {
+    startSync();
+  }
+  while (syncState != SyncState::idle) {
+    sleep_until(pollTime);
+    poll();
+  }
+}
+
+///
+/// \description The change of the reference's seconds is found within a coarse poll, so
+///   the next one is a second later, and is polled for finely from just before it. This
+///   takes about 50 reads over two seconds.
+///
+void Rp2040RtcCacheDevice::poll() {
+  if (syncState == SyncState::idle) {
+    if (time_reached(nextSyncTime)) {
+      startSync();
+    }
+    return;
+  }
+  if (!time_reached(pollTime)) {
+    return;
+  }
+  
+  switch (syncState) {
+  case SyncState::coarse:
+    pollReference(coarsePollMs);
+    // Polling goes on from a reference that has stopped, and the sync sets the RTC from
+    // its last read, as it would from a running one.
+    if (pollClockDatum.time.seconds != pollSeconds || time_reached(pollTimeout)) {
+      syncState = SyncState::waiting;
+      pollTime = make_timeout_time_ms(1000 - coarsePollMs - finePollLeadMs);
+    }
+    break;
+  case SyncState::waiting:
+    syncState = SyncState::fine;
+    pollSeconds = pollClockDatum.time.seconds;
+    pollTimeout = make_timeout_time_ms(tickTimeoutMs);
+    break;
+  case SyncState::fine:
+    pollReference(finePollMs);
+    if (pollClockDatum.time.seconds != pollSeconds || time_reached(pollTimeout)) {
+      finishSync(get_absolute_time());
+    }
+    break;
+  case SyncState::idle:
+    break;
+  }
+}
+
+void Rp2040RtcCacheDevice::startSync() {
+  syncState = SyncState::coarse;
+  pollReference(coarsePollMs);
+  pollSeconds = pollClockDatum.time.seconds;
+  pollTimeout = make_timeout_time_ms(tickTimeoutMs);
+}
+
+///
+/// \brief Read the reference, and take the next read after a poll period.
+///
+void Rp2040RtcCacheDevice::pollReference(uint32_t pollMs) {
+  pollClockDatum = referenceDevice.read();
+  ++referenceReadCount;
+  pollTime = make_timeout_time_ms(pollMs);
+}
+
+///
+/// \brief Set the RTC from the reference's time just after its seconds changed.
+/// \description The drift is the system timer's time between the reference's ticks at
+///   this sync and the last, less the reference's.
+///
+/// \param tickTime The time the change was seen.
+///
+void Rp2040RtcCacheDevice::finishSync(absolute_time_t tickTime) {
+  setLocal(pollClockDatum);
+  
+  auto epochSeconds = EpochSeconds::fromClockDatum(pollClockDatum);
+  if (syncCount > 0) {
+    driftInterval = (epochSeconds - syncEpochSeconds) * 1000000;
+    drift = absolute_time_diff_us(syncTime, tickTime) - driftInterval;
+  }
+  syncTime = tickTime;
+  syncEpochSeconds = epochSeconds;
+  ++syncCount;
+  nextSyncTime = delayed_by_ms(tickTime, syncInterval * 1000);
+  syncState = SyncState::idle;
+}
+
+float Rp2040RtcCacheDevice::getDriftPpm() const {
+  if (driftInterval == 0) {
+    return 0.0f;
+  }
+  return static_cast<float>(drift) * 1.0e6f / static_cast<float>(driftInterval);
+}
+
+///
+/// \description Polls first, so syncs go on for callers that only read.
+///
+ClockDatum Rp2040RtcCacheDevice::readLocal() {
+  poll();
+  
+  datetime_t datetime;
+  rtc_get_datetime(&datetime);
+  ++localReadCount;
+  return ClockDatum(
+    Time(static_cast<uint8_t>(datetime.sec), static_cast<uint8_t>(datetime.min), 
+      static_cast<uint8_t>(datetime.hour)),
+    Date(static_cast<uint8_t>(datetime.dotw + 1), static_cast<uint8_t>(datetime.day),
+      static_cast<uint8_t>(datetime.month), static_cast<uint8_t>(datetime.year - rtcYearBase))
+  );
+}
+
+///
+/// \description The reference counts the days of the week from 1 for Sunday, the RTC 
+///   from 0. The day is taken from the date, which the RTC does not check it against.
+///
+void Rp2040RtcCacheDevice::setLocal(ClockDatum clockDatum) {
+  datetime_t datetime = {
+    .year = static_cast<int16_t>(rtcYearBase + clockDatum.date.year),
+    .month = static_cast<int8_t>(clockDatum.date.month),
+    .day = static_cast<int8_t>(clockDatum.date.dayOfMonth),
+    .dotw = static_cast<int8_t>(clockDatum.date.derivedDayOfWeek() - 1),
+    .hour = static_cast<int8_t>(clockDatum.time.hour),
+    .min = static_cast<int8_t>(clockDatum.time.minutes),
+    .sec = static_cast<int8_t>(clockDatum.time.seconds)
+  };
+  rtc_set_datetime(&datetime);
+  sleep_us(rtcSettleUs);
+}
@@ -34,6 +34,8 @@
 
 #include "AlsConfigRegister.h"
 #include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <cstdio>
 
@@ -43,11 +45,52 @@ constexpr AlsConfigRegister::Gain default_gain = AlsConfigRegister::low;
 constexpr AlsConfigRegister::IntegrationTime default_integration_time 
   = LightMeter::AlsConfigRegister::ms_100;
 
-const uint8_t gain_values[] = {0x02, 0x03, 0x00, 0x01};
+// Register encodings, indexed by gain and integration time.
 constexpr int gain_values_count = 4;
-const uint8_t integration_time_values[] = {0x0c, 0x08, 0x00, 0x01, 0x02, 0x03};
+constexpr std::array<uint8_t, gain_values_count> gain_values = {0x02, 0x03, 0x00, 0x01};
 constexpr int integration_time_values_count = 6;
+constexpr std::array<uint8_t, integration_time_values_count> integration_time_values = {
+  0x0c, 0x08, 0x00, 0x01, 0x02, 0x03
+};
 
+// Decoding tables, indexed by every value of the register fields. Values not in the 
+// encodings decode to the defaults.
+constexpr size_t gain_field_values_count = 1 << 2;
+constexpr size_t integration_time_field_values_count = 1 << 4;
+
+template <typename Setting, size_t field_values_count, size_t values_count>
+constexpr std::array<Setting, field_values_count> 
+makeDecodingTable(const std::array<uint8_t, values_count>& values, Setting default_setting) {
+  std::array<Setting, field_values_count> table;
+  table.fill(default_setting);
+  for (size_t index = 0; index < values_count; ++index) {
+    table[values[index]] = Setting(index);
+  }
+  return table;
+}
+
+constexpr auto gain_settings = makeDecodingTable<AlsConfigRegister::Gain, gain_field_values_count>(
+  gain_values, default_gain);
+constexpr auto integration_time_settings 
+  = makeDecodingTable<AlsConfigRegister::IntegrationTime, integration_time_field_values_count>(
+    integration_time_values, default_integration_time);
+
+template <typename Setting, size_t field_values_count, size_t values_count>
+constexpr bool checkRoundTrip(const std::array<uint8_t, values_count>& values,
+                              const std::array<Setting, field_values_count>& settings) 
+{
+  for (size_t index = 0; index < values_count; ++index) {
+    if (values[index] >= field_values_count || settings[values[index]] != Setting(index)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static_assert(checkRoundTrip(gain_values, gain_settings), 
+              "Every gain must decode to itself.");
+static_assert(checkRoundTrip(integration_time_values, integration_time_settings), 
+              "Every integration time must decode to itself.");
 
 AlsConfigRegister::AlsConfigRegister() : value(0x0001) {
   setGain(default_gain);
@@ -55,22 +98,11 @@ AlsConfigRegister::AlsConfigRegister() : value(0x0001) {
 }
 
 void AlsConfigRegister::setGain(Gain gain) {
-  auto value = gain_values[gain];
-  setting.gain = value;
+  setting.gain = gain_values[gain];
 }
 
-AlsConfigRegister::Gain AlsConfigRegister::getGain() {
-  auto value = setting.gain;
-  
-  Gain gain = low;
-  int index = 0;
-  for (int index = 0; index < gain_values_count; ++index) {
-    if (gain_values[index] == value) {
-      gain = Gain(index);
-    }
-  }
-
-  return gain;
+AlsConfigRegister::Gain AlsConfigRegister::getGain() const {
+  return gain_settings[setting.gain];
 }
 
 void AlsConfigRegister::increaseGain() {
@@ -93,17 +125,9 @@ void AlsConfigRegister::setIntegrationTime(IntegrationTime time) {
   setting.integration_time_upper = value >> 2;
 }
 
-AlsConfigRegister::IntegrationTime AlsConfigRegister::getIntegrationTime() {
+AlsConfigRegister::IntegrationTime AlsConfigRegister::getIntegrationTime() const {
   uint8_t value = (setting.integration_time_lower | (setting.integration_time_upper << 2));
-  
-  IntegrationTime time = ms_100;
-  for (int index = 0; index < integration_time_values_count; ++index) {
-    if (integration_time_values[index] == value) {
-      time = IntegrationTime(index);
-    }
-  }
-  
-  return time;
+  return integration_time_settings[value];
 }
 
 void AlsConfigRegister::increaseIntegrationTime() {
@@ -118,4 +142,4 @@ void AlsConfigRegister::decreaseIntegrationTime() {
   int time_index = static_cast<int>(time) - 1;
   time_index = std::max(time_index, 0);
   setIntegrationTime(IntegrationTime(time_index));
-}
\ No newline at end of file
+}
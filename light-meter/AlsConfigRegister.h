@@ -81,16 +81,68 @@ struct AlsConfigRegister {
   AlsConfigRegister(uint16_t value) : value(value) {}
   
   void setGain(Gain);
-  Gain getGain();
+  Gain getGain() const;
   void increaseGain();
   void decreaseGain();
 
   void setIntegrationTime(IntegrationTime);
-  IntegrationTime getIntegrationTime();  
+  IntegrationTime getIntegrationTime() const;
   void increaseIntegrationTime();
   void decreaseIntegrationTime();
 };
 
+//
+// Power saving mode register. When enabled the sensor waits between integrations
+// for the mode's refresh time, lowering its current draw.
+//
+struct PowerSavingRegister {
+  union {
+    uint16_t value;
+    struct {
+      uint8_t lsb : 8;
+      uint8_t msb : 8;
+    } data_byte;
+    struct {
+      uint8_t enable  : 1;
+      uint8_t mode    : 2;
+    } setting;
+  };
+  
+  enum Enable : uint8_t { disable, enable };
+  enum Mode : uint8_t {
+    mode_1, // 500 ms wait
+    mode_2, // 1000 ms wait
+    mode_3, // 2000 ms wait
+    mode_4  // 4000 ms wait
+  };
+  
+  PowerSavingRegister() : value(0x0000) {}
+  PowerSavingRegister(uint16_t value) : value(value) {}
+};
+
+//
+// Interrupt status register. Flags which threshold the ambient light counts crossed. 
+// The flags are cleared when the register is read.
+//
+struct InterruptStatusRegister {
+  union {
+    uint16_t value;
+    struct {
+      uint8_t lsb : 8;
+      uint8_t msb : 8;
+    } data_byte;
+    struct {
+      uint8_t                   : 8;
+      uint8_t                   : 6;
+      uint8_t threshold_high    : 1;
+      uint8_t threshold_low     : 1;
+    } setting;
+  };
+  
+  InterruptStatusRegister() : value(0x0000) {}
+  InterruptStatusRegister(uint16_t value) : value(value) {}
+};
+
 }; // namespace LightMeter
 
 #endif //  ALSCONFIGREGISTER_H
\ No newline at end of file
@@ -0,0 +1,72 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#ifndef CALIBRATIONPROFILE_H
+#define CALIBRATIONPROFILE_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace LightMeter {
+
+//
+// A sensor's calibration against a reference meter. Each gain setting is a range with 
+// its own gain and offset applied to the nominal lux, and an optional correction curve
+// replaces the datasheet's non-linearity polynomial for bright light at low gains.
+//
+struct CalibrationProfile {
+  static constexpr size_t range_count = 4;
+  static constexpr size_t maximum_curve_points = 8;
+  static constexpr int gain_fraction_bits = 16;
+  static constexpr int32_t unity_gain = 1 << gain_fraction_bits;
+  
+  struct CurvePoint {
+    /// \brief Calibrated lux before correction, scaled by the lux scale.
+    uint32_t lux;
+    /// \brief Correction factor at the lux in Q16.
+    int32_t factor;
+  };
+  
+  /// \brief Gain for each gain setting's range in Q16.
+  int32_t gains[range_count] = {unity_gain, unity_gain, unity_gain, unity_gain};
+  /// \brief Offset for each gain setting's range, scaled by the lux scale.
+  int32_t offsets[range_count] = {};
+  /// \brief Points of the correction curve ordered by lux, none to use the polynomial.
+  uint32_t curvePointCount = 0;
+  CurvePoint curve[maximum_curve_points] = {};
+};
+
+}; // namespace LightMeter
+
+#endif // CALIBRATIONPROFILE_H
@@ -0,0 +1,105 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "CalibrationStore.h"
+
+#include <cstring>
+
+#include "hardware/sync.h"
+#include "pico/stdlib.h"
+
+#include "Crc.h"
+
+using namespace LightMeter;
+
+constexpr uint32_t store_offset = PICO_FLASH_SIZE_BYTES - FLASH_SECTOR_SIZE;
+constexpr uint32_t record_magic = 0x4c43414c; // "LCAL"
+constexpr uint32_t record_version = 1;
+
+struct Record {
+  uint32_t magic;
+  uint32_t version;
+  CalibrationProfile profile;
+  uint32_t crc;
+};
+static_assert(sizeof(Record) <= FLASH_PAGE_SIZE, "A profile must fit in a flash page.");
+
+static uint32_t recordCrc(const Record& record) {
+  return Core::crc32(reinterpret_cast<const uint8_t*>(&record), offsetof(Record, crc));
+}
+
+bool CalibrationStore::load(size_t sensor_index, CalibrationProfile& profile) const {
+  if (sensor_index >= profile_capacity) {
+    return false;
+  }
+  
+  Record record;
+  auto page = reinterpret_cast<const uint8_t*>(XIP_BASE + store_offset) 
+    + sensor_index * FLASH_PAGE_SIZE;
+  std::memcpy(&record, page, sizeof(record));
+  if (record.magic != record_magic || record.version != record_version 
+      || record.crc != recordCrc(record)) {
+    return false;
+  }
+  
+  profile = record.profile;
+  return true;
+}
+
+///
+/// \brief Save a sensor's calibration profile.
+///
+/// \details Flash is erased a sector at a time, so the sector is copied to RAM, the
+///   sensor's page replaced and the whole sector programmed back. Code can't run from
+///   flash while it is erased or programmed, so interrupts are disabled throughout.
+///
+void CalibrationStore::save(size_t sensor_index, const CalibrationProfile& profile) {
+  if (sensor_index >= profile_capacity) {
+    return;
+  }
+  
+  static uint8_t sector[FLASH_SECTOR_SIZE];
+  std::memcpy(sector, reinterpret_cast<const uint8_t*>(XIP_BASE + store_offset), sizeof(sector));
+  
+  Record record = {record_magic, record_version, profile, 0};
+  record.crc = recordCrc(record);
+  uint8_t* page = &sector[sensor_index * FLASH_PAGE_SIZE];
+  std::memset(page, 0xff, FLASH_PAGE_SIZE);
+  std::memcpy(page, &record, sizeof(record));
+  
+  uint32_t interrupts = save_and_disable_interrupts();
+  flash_range_erase(store_offset, FLASH_SECTOR_SIZE);
+  flash_range_program(store_offset, sector, FLASH_SECTOR_SIZE);
+  restore_interrupts(interrupts);
+}
@@ -0,0 +1,74 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#ifndef CALIBRATIONSTORE_H
+#define CALIBRATIONSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "hardware/flash.h"
+
+#include "CalibrationProfile.h"
+
+namespace LightMeter {
+
+//
+// Keeps a calibration profile for each sensor in the last sector of flash, one page
+// each, checked with a CRC-32 so an erased or partly written page is not loaded. 
+// Profiles are read in place through the XIP window.
+//
+class CalibrationStore {
+public:
+  static constexpr size_t profile_capacity = FLASH_SECTOR_SIZE / FLASH_PAGE_SIZE;
+  
+  CalibrationStore() = default;
+  ~CalibrationStore() = default;
+  
+  //
+  // Load the sensor's profile. Returns false, leaving the profile as it was, if none
+  // has been saved.
+  //
+  bool load(size_t sensor_index, CalibrationProfile& profile) const;
+  //
+  // Save the sensor's profile. The sector is erased and reprogrammed with the other
+  // sensors' profiles, so this stalls the core, with interrupts disabled, for tens
+  // of milliseconds.
+  //
+  void save(size_t sensor_index, const CalibrationProfile& profile);
+}; // class CalibrationStore
+
+}; // namespace LightMeter
+
+#endif // CALIBRATIONSTORE_H
@@ -0,0 +1,184 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "Calibrator.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace LightMeter;
+
+// Fitted gains outside these are taken as a bad reference reading rather than the unit.
+constexpr double minimum_gain = 0.5;
+constexpr double maximum_gain = 2.0;
+
+bool Calibrator::add(uint8_t sensor_index, const LightSensor& sensor, uint32_t reference_lux) {
+  if (pointCount == maximum_points) {
+    return false;
+  }
+  
+  points[pointCount++] = {
+    sensor_index, sensor.getGainWhenRead(), sensor.getUncalibratedLux(), reference_lux
+  };
+  return true;
+}
+
+void Calibrator::clear(uint8_t sensor_index) {
+  auto end = std::remove_if(&points[0], &points[pointCount], 
+                            [=](const Point& point) { return point.sensor == sensor_index; });
+  pointCount = end - &points[0];
+}
+
+size_t Calibrator::getPointCount(uint8_t sensor_index) const {
+  return std::count_if(&points[0], &points[pointCount],
+                       [=](const Point& point) { return point.sensor == sensor_index; });
+}
+
+///
+/// \brief Fit a calibration profile for a sensor.
+///
+/// \details Ranges without linear points keep unity gain and no offset, and without 
+///   non-linear points the profile has no curve, leaving the polynomial correction.
+///
+/// \param sensor_index The sensor to fit.
+/// \param profile The profile to set when the fit succeeds.
+/// \return True if the profile was fitted.
+///
+bool Calibrator::fit(uint8_t sensor_index, CalibrationProfile& profile) const {
+  if (getPointCount(sensor_index) == 0) {
+    return false;
+  }
+  
+  CalibrationProfile fitted;
+  for (int gain = AlsConfigRegister::low; gain <= AlsConfigRegister::high; ++gain) {
+    if (!fitRange(sensor_index, AlsConfigRegister::Gain(gain), fitted)) {
+      return false;
+    }
+  }
+  fitCurve(sensor_index, fitted);
+  
+  profile = fitted;
+  return true;
+}
+
+///
+/// \brief Fit the gain and offset of a gain setting's range by least squares.
+///
+/// \details Only points in the linear region are used. A single point, or points at the
+///   same lux, give a gain through the origin with no offset.
+///
+/// \return False if the fitted gain is implausible.
+///
+bool Calibrator::fitRange(uint8_t sensor_index, AlsConfigRegister::Gain gain,
+                          CalibrationProfile& profile) const {
+  double count = 0;
+  double sum_measured = 0;
+  double sum_reference = 0;
+  double sum_measured_squared = 0;
+  double sum_products = 0;
+  for (size_t index = 0; index < pointCount; ++index) {
+    auto& point = points[index];
+    if (point.sensor != sensor_index || point.gain != gain 
+        || LightSensor::isNonLinear(point.measured, gain)) {
+      continue;
+    }
+    count += 1;
+    sum_measured += point.measured;
+    sum_reference += point.reference;
+    sum_measured_squared += static_cast<double>(point.measured) * point.measured;
+    sum_products += static_cast<double>(point.measured) * point.reference;
+  }
+  
+  if (count == 0) {
+    return true;
+  }
+  if (sum_measured == 0) {
+    return false;
+  }
+  
+  double range_gain = sum_reference / sum_measured;
+  double offset = 0;
+  double denominator = count * sum_measured_squared - sum_measured * sum_measured;
+  if (count > 1 && denominator > 1e-6 * count * sum_measured_squared) {
+    range_gain = (count * sum_products - sum_measured * sum_reference) / denominator;
+    offset = (sum_reference - range_gain * sum_measured) / count;
+  }
+  
+  if (range_gain < minimum_gain || range_gain > maximum_gain) {
+    return false;
+  }
+  profile.gains[gain] = std::lround(range_gain * CalibrationProfile::unity_gain);
+  profile.offsets[gain] = std::lround(std::clamp<double>(offset, INT32_MIN, INT32_MAX));
+  return true;
+}
+
+///
+/// \brief Fit a correction curve from the points in the non-linear region.
+///
+/// \details Each point's correction factor is the reference over its lux calibrated by
+///   the range's gain and offset. The points are kept ordered by calibrated lux, dropping
+///   repeats of a lux and any beyond the curve's capacity.
+///
+void Calibrator::fitCurve(uint8_t sensor_index, CalibrationProfile& profile) const {
+  profile.curvePointCount = 0;
+  for (size_t index = 0; index < pointCount; ++index) {
+    auto& point = points[index];
+    if (point.sensor != sensor_index || !LightSensor::isNonLinear(point.measured, point.gain)) {
+      continue;
+    }
+    
+    int64_t calibrated = ((static_cast<int64_t>(point.measured) * profile.gains[point.gain]) 
+      >> CalibrationProfile::gain_fraction_bits) + profile.offsets[point.gain];
+    if (calibrated <= 0 || calibrated > UINT32_MAX 
+        || profile.curvePointCount == CalibrationProfile::maximum_curve_points) {
+      continue;
+    }
+    
+    auto begin = &profile.curve[0];
+    auto end = &profile.curve[profile.curvePointCount];
+    auto position = std::lower_bound(begin, end, calibrated, 
+      [](const CalibrationProfile::CurvePoint& curve_point, int64_t lux) { 
+        return curve_point.lux < lux; 
+      });
+    if (position != end && position->lux == calibrated) {
+      continue;
+    }
+    
+    std::copy_backward(position, end, end + 1);
+    position->lux = static_cast<uint32_t>(calibrated);
+    position->factor = static_cast<int32_t>(
+      (static_cast<int64_t>(point.reference) << CalibrationProfile::gain_fraction_bits) / calibrated);
+    ++profile.curvePointCount;
+  }
+}
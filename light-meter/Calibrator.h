@@ -0,0 +1,96 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#ifndef CALIBRATOR_H
+#define CALIBRATOR_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "AlsConfigRegister.h"
+#include "CalibrationProfile.h"
+#include "LightSensor.h"
+
+namespace LightMeter {
+
+//
+// Fits calibration profiles on the device from readings taken alongside a reference
+// meter. Each reading's uncalibrated lux is paired with the reference lux, and a profile
+// is fitted for a sensor from its pairs: a least squares gain and offset for each gain
+// setting's range from the linear readings, and a correction curve from the rest.
+//
+class Calibrator {
+public:
+  static constexpr size_t maximum_points = 32;
+  
+  struct Point {
+    uint8_t sensor;
+    AlsConfigRegister::Gain gain;
+    /// \brief Uncalibrated lux scaled by the lux scale.
+    uint32_t measured;
+    /// \brief Reference lux scaled by the lux scale.
+    uint32_t reference;
+  };
+  
+  Calibrator() = default;
+  ~Calibrator() = default;
+  
+  //
+  // Pair the sensor's last reading with the reference lux, scaled by the lux scale.
+  // Returns false when there is no room for the point.
+  //
+  bool add(uint8_t sensor_index, const LightSensor& sensor, uint32_t reference_lux);
+  //
+  // Remove the sensor's points.
+  //
+  void clear(uint8_t sensor_index);
+  size_t getPointCount(uint8_t sensor_index) const;
+  //
+  // Fit a profile from the sensor's points. Returns false, leaving the profile as it
+  // was, without points or when a fitted gain is implausible.
+  //
+  bool fit(uint8_t sensor_index, CalibrationProfile& profile) const;
+  
+private:
+  Point points[maximum_points];
+  size_t pointCount = 0;
+  
+  bool fitRange(uint8_t sensor_index, AlsConfigRegister::Gain gain, 
+                CalibrationProfile& profile) const;
+  void fitCurve(uint8_t sensor_index, CalibrationProfile& profile) const;
+}; // class Calibrator
+
+}; // namespace LightMeter
+
+#endif // CALIBRATOR_H
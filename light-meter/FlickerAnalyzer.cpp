@@ -0,0 +1,179 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "FlickerAnalyzer.h"
+
+#include <algorithm>
+#include <array>
+
+using namespace LightMeter;
+
+constexpr int coefficient_fraction_bits = 14;
+// Deviations from the mean are shifted down to this many bits before filtering, 
+// keeping the Goertzel products within 64 bits.
+constexpr int deviation_bits = 15;
+
+constexpr size_t bin_count = FlickerAnalyzer::sample_capacity / 2 + 1;
+
+constexpr double cosine(double angle) {
+  constexpr double pi = 3.14159265358979323846;
+  while (angle > pi) {
+    angle -= 2 * pi;
+  }
+  double term = 1;
+  double sum = 1;
+  for (int order = 2; order < 30; order += 2) {
+    term *= -angle * angle / ((order - 1) * order);
+    sum += term;
+  }
+  return sum;
+}
+
+// Goertzel coefficients, 2 cos(2 pi k / N) for each bin k, in Q14.
+constexpr std::array<int32_t, bin_count> makeGoertzelCoefficients() {
+  constexpr double pi = 3.14159265358979323846;
+  std::array<int32_t, bin_count> coefficients;
+  for (size_t bin = 0; bin < bin_count; ++bin) {
+    double angle = 2 * pi * bin / FlickerAnalyzer::sample_capacity;
+    double coefficient = 2 * cosine(angle) * (1 << coefficient_fraction_bits);
+    coefficients[bin] = static_cast<int32_t>(coefficient < 0 ? coefficient - 0.5 : coefficient + 0.5);
+  }
+  return coefficients;
+}
+
+constexpr auto goertzel_coefficients = makeGoertzelCoefficients();
+static_assert(goertzel_coefficients[0] == 2 << coefficient_fraction_bits);
+static_assert(goertzel_coefficients[bin_count - 1] == -(2 << coefficient_fraction_bits));
+
+bool FlickerAnalyzer::add(uint32_t lux, uint32_t timestamp_ms) {
+  if (full()) {
+    return false;
+  }
+  
+  if (sampleCount == 0) {
+    firstTimestamp = timestamp_ms;
+  }
+  lastTimestamp = timestamp_ms;
+  samples[sampleCount++] = lux;
+  return true;
+}
+
+bool FlickerAnalyzer::analyze() {
+  if (sampleCount == 0) {
+    flickerPercent = 0;
+    flickerIndex = 0;
+    dominantFrequency = 0;
+    sampleRate = 0;
+    return false;
+  }
+  
+  uint32_t minimum = UINT32_MAX;
+  uint32_t maximum = 0;
+  uint64_t total = 0;
+  for (size_t index = 0; index < sampleCount; ++index) {
+    minimum = std::min(minimum, samples[index]);
+    maximum = std::max(maximum, samples[index]);
+    total += samples[index];
+  }
+  uint32_t mean = total / sampleCount;
+  
+  uint64_t range = maximum - minimum;
+  uint64_t sum = static_cast<uint64_t>(maximum) + minimum;
+  flickerPercent = sum > 0 ? (range * 100 * 100) / sum : 0;
+  
+  uint64_t area_above_mean = 0;
+  for (size_t index = 0; index < sampleCount; ++index) {
+    if (samples[index] > mean) {
+      area_above_mean += samples[index] - mean;
+    }
+  }
+  flickerIndex = total > 0 ? (area_above_mean * 1000) / total : 0;
+  
+  uint32_t duration = lastTimestamp - firstTimestamp;
+  sampleRate = duration > 0 ? ((sampleCount - 1) * 100000) / duration : 0;
+  
+  uint32_t maximum_deviation = std::max(maximum - mean, mean - minimum);
+  size_t bin = findDominantBin(mean, maximum_deviation);
+  dominantFrequency = (bin * sampleRate) / sampleCount;
+  return true;
+}
+
+//
+// Private Interface
+//
+
+///
+/// \brief Find the DFT bin with the most power.
+///
+/// \details Runs a Goertzel filter for each bin above DC over the deviations from the mean,
+///   which are scaled to at most 15 bits. The filter states then grow to about 24 bits,
+///   and 26 bits in the last bin, at half the sample rate, where the filter's two poles
+///   coincide. So they fit in 32 bits, and the power of each bin in 64 bits.
+///
+/// \return The bin with the most power, or zero if the readings are constant.
+///
+size_t FlickerAnalyzer::findDominantBin(uint32_t mean, uint32_t maximum_deviation) const {
+  if (maximum_deviation == 0 || sampleCount != sample_capacity) {
+    return 0;
+  }
+  
+  int shift = 0;
+  while ((maximum_deviation >> shift) >= (1u << deviation_bits)) {
+    ++shift;
+  }
+  
+  size_t dominant_bin = 0;
+  int64_t dominant_power = 0;
+  for (size_t bin = 1; bin < bin_count; ++bin) {
+    int64_t coefficient = goertzel_coefficients[bin];
+    int64_t state = 0;
+    int64_t previous_state = 0;
+    int64_t older_state = 0;
+    for (size_t index = 0; index < sampleCount; ++index) {
+      int64_t deviation = (static_cast<int64_t>(samples[index]) - mean) >> shift;
+      state = deviation + ((coefficient * previous_state) >> coefficient_fraction_bits) 
+        - older_state;
+      older_state = previous_state;
+      previous_state = state;
+    }
+    int64_t power = previous_state * previous_state + older_state * older_state
+      - ((coefficient * previous_state) >> coefficient_fraction_bits) * older_state;
+    if (power > dominant_power) {
+      dominant_power = power;
+      dominant_bin = bin;
+    }
+  }
+  
+  return dominant_bin;
+}
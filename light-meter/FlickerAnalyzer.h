@@ -0,0 +1,96 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#ifndef FLICKERANALYZER_H
+#define FLICKERANALYZER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace LightMeter {
+
+//
+// Analyzes a burst of back to back light readings for flicker, in integer math. 
+// Flicker percent and flicker index follow IES RP-16 definitions, and the dominant 
+// frequency is found with a bank of Goertzel filters, one per DFT bin.
+//
+// The sensor integrates each reading, so the sample rate is at most 1 / 25 ms and only 
+// flicker below half that is resolved. Faster flicker, such as from mains or PWM 
+// dimming, is averaged out by the integration or aliased to a lower frequency.
+//
+class FlickerAnalyzer {
+public:
+  static constexpr size_t sample_capacity = 64;
+  
+  FlickerAnalyzer() = default;
+  ~FlickerAnalyzer() = default;
+  
+  void reset() { sampleCount = 0; }
+  //
+  // Add a reading. Returns false once the burst is full.
+  //
+  bool add(uint32_t lux, uint32_t timestamp_ms);
+  bool full() const { return sampleCount == sample_capacity; }
+  //
+  // Analyze the burst, which is full for the dominant frequency. Returns false, with
+  // every result zero, when there are no readings.
+  //
+  bool analyze();
+  
+  /// \brief Flicker percent scaled by 100.
+  uint32_t getFlickerPercent() const { return flickerPercent; }
+  /// \brief Flicker index scaled by 1000.
+  uint32_t getFlickerIndex() const { return flickerIndex; }
+  /// \brief Dominant frequency in hundredths of a hertz, zero without flicker.
+  uint32_t getDominantFrequency() const { return dominantFrequency; }
+  /// \brief Sample rate of the burst in hundredths of a hertz.
+  uint32_t getSampleRate() const { return sampleRate; }
+  
+private:
+  uint32_t samples[sample_capacity];
+  size_t sampleCount = 0;
+  uint32_t firstTimestamp = 0;
+  uint32_t lastTimestamp = 0;
+  
+  uint32_t flickerPercent = 0;
+  uint32_t flickerIndex = 0;
+  uint32_t dominantFrequency = 0;
+  uint32_t sampleRate = 0;
+  
+  size_t findDominantBin(uint32_t mean, uint32_t maximum_deviation) const;
+}; // class FlickerAnalyzer
+
+}; // namespace LightMeter
+
+#endif // FLICKERANALYZER_H
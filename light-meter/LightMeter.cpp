@@ -40,16 +40,183 @@
 #include "hardware/i2c.h"
 #include "pico/stdlib.h"
 
+#include "CalibrationStore.h"
+#include "Calibrator.h"
 #include "Display.h"
+#include "FlickerAnalyzer.h"
 #include "LightSensor.h"
 #include "FontManager.h"
+#include "Sampler.h"
+#include "SensorBus.h"
 
 using namespace LightMeter;
 
+constexpr uint32_t reading_period_ms = 1500;
+// The display is only refreshed when the light leaves this band around the last reading.
+constexpr uint8_t watch_band_percent = 10;
+
+//
+// Commands read from USB to switch between watching for light changes, continuous
+// sampling and flicker analysis, and to export the samples.
+//
+constexpr int watch_command = 'w';
+constexpr int sample_command = 's';
+constexpr int flicker_command = 'f';
+constexpr int export_command = 'e';
+//
+// Calibration commands are a line, 'c' followed by one of:
+//   <lux> [sensor]  pair the sensor's last reading with a reference meter's lux
+//   fit [sensor]    fit and apply a profile from the sensor's pairs
+//   save [sensor]   save the sensor's profile to flash
+//   clear [sensor]  drop the sensor's pairs and profile
+//   show [sensor]   write the sensor's profile
+// The sensor defaults to the first.
+//
+constexpr int calibrate_command = 'c';
+constexpr uint32_t command_line_timeout_us = 1000 * 1000;
+constexpr size_t command_line_size = 32;
+
+enum class Mode { watch, sample, flicker };
+
+// Light sensors to sample, each on its own channel of an I2C multiplexer. A single 
+// sensor is connected directly to the bus. The first sensor is the one watched and
+// displayed.
+constexpr size_t sensor_count = 1;
+
+//
+// Write the samples and statistics over USB as comma separated values.
+//
+static void exportSamples(const Sampler& sampler) {
+  auto& samples = sampler.getSamples();
+  printf("timestamp_ms,sensor,lux,white\n");
+  for (size_t index = 0; index < samples.size(); ++index) {
+    auto& sample = samples[index];
+    printf("%lu,%u,%.2f,%.2f\n", sample.timestamp, sample.sensor, sample.lux, 
+           sample.whiteChannel);
+  }
+  
+  printf("sensor,count,minimum,maximum,mean,variance,ema,median\n");
+  for (size_t sensor = 0; sensor < sampler.getSensorCount(); ++sensor) {
+    auto& statistics = sampler.getStatistics(sensor);
+    printf("%u,%lu,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f\n", sensor, statistics.getCount(), 
+           statistics.getMinimum(), statistics.getMaximum(), statistics.getMean(),
+           statistics.getVariance(), statistics.getMovingAverage(), statistics.getMedian());
+  }
+}
+
+//
+// Read the rest of a command line. Characters are waited on for a short time, so a line
+// that is not finished is discarded.
+//
+static bool readCommandLine(char* line, size_t size) {
+  size_t length = 0;
+  while (true) {
+    int character = getchar_timeout_us(command_line_timeout_us);
+    if (character == PICO_ERROR_TIMEOUT) {
+      return false;
+    }
+    if (character == '\n' || character == '\r') {
+      line[length] = '\0';
+      return true;
+    }
+    if (length < size - 1) {
+      line[length++] = character;
+    }
+  }
+}
+
+static void showCalibration(const CalibrationProfile& profile, size_t sensor) {
+  printf("sensor,range,gain,offset_lux\n");
+  for (size_t range = 0; range < CalibrationProfile::range_count; ++range) {
+    printf("%u,%u,%.4f,%.4f\n", sensor, range, 
+           static_cast<float>(profile.gains[range]) / CalibrationProfile::unity_gain,
+           static_cast<float>(profile.offsets[range]) / LightSensor::lux_scale);
+  }
+  printf("sensor,curve_lux,curve_factor\n");
+  for (size_t index = 0; index < profile.curvePointCount; ++index) {
+    printf("%u,%.2f,%.4f\n", sensor, 
+           static_cast<float>(profile.curve[index].lux) / LightSensor::lux_scale,
+           static_cast<float>(profile.curve[index].factor) / CalibrationProfile::unity_gain);
+  }
+}
+
+//
+// Carry out a calibration command line on the sensors.
+//
+static void calibrate(const char* line, LightSensor* sensors, Calibrator& calibrator, 
+                      CalibrationStore& store) {
+  char action[8] = "";
+  unsigned sensor = 0;
+  float reference_lux = 0;
+  if (sscanf(line, " %f %u", &reference_lux, &sensor) < 1 
+      && sscanf(line, " %7s %u", action, &sensor) < 1) {
+    printf("Calibration command not recognized\n");
+    return;
+  }
+  if (sensor >= sensor_count) {
+    printf("No sensor %u\n", sensor);
+    return;
+  }
+  
+  LightSensor& light_sensor = sensors[sensor];
+  if (action[0] == '\0') {
+    bool added = reference_lux > 0 && light_sensor.getUncalibratedLux() > 0 
+      && calibrator.add(sensor, light_sensor, 
+                        static_cast<uint32_t>(reference_lux * LightSensor::lux_scale + 0.5f));
+    printf(added ? "Added point %u for sensor %u\n" : "Point %u for sensor %u not added\n",
+           calibrator.getPointCount(sensor), sensor);
+  } else if (strcmp(action, "fit") == 0) {
+    CalibrationProfile profile;
+    if (!calibrator.fit(sensor, profile)) {
+      printf("Calibration fit failed for sensor %u\n", sensor);
+    } else if (!light_sensor.setCalibration(profile)) {
+      printf("Calibration for sensor %u rejected, a gain is out of range\n", sensor);
+    } else {
+      showCalibration(profile, sensor);
+    }
+  } else if (strcmp(action, "save") == 0) {
+    store.save(sensor, light_sensor.getCalibration());
+    printf("Calibration saved for sensor %u\n", sensor);
+  } else if (strcmp(action, "clear") == 0) {
+    calibrator.clear(sensor);
+    light_sensor.setCalibration(CalibrationProfile());
+  } else if (strcmp(action, "show") == 0) {
+    showCalibration(light_sensor.getCalibration(), sensor);
+  } else {
+    printf("Calibration command not recognized\n");
+  }
+}
+
+//
+// Show a flicker analysis on the display and write it over USB.
+//
+static void showFlicker(const FlickerAnalyzer& analyzer, Display& display) {
+  float flicker_percent = analyzer.getFlickerPercent() / 100.0f;
+  float flicker_index = analyzer.getFlickerIndex() / 1000.0f;
+  float frequency = analyzer.getDominantFrequency() / 100.0f;
+  display.draw(flicker_percent, 0);
+  display.draw(flicker_index, 1);
+  display.draw(frequency, 2);
+  printf("flicker_percent,flicker_index,frequency_hz,sample_rate_hz\n");
+  printf("%.2f,%.3f,%.2f,%.2f\n", flicker_percent, flicker_index, frequency,
+         analyzer.getSampleRate() / 100.0f);
+}
+
 int main() {
   Display display;
-  LightSensor light_sensor;
+  I2cMultiplexer multiplexer;
+  LightSensor light_sensors[sensor_count];
+  if (sensor_count > 1) {
+    for (size_t channel = 0; channel < sensor_count; ++channel) {
+      light_sensors[channel] = LightSensor(SensorBus(multiplexer, channel));
+    }
+  }
+  LightSensor& light_sensor = light_sensors[0];
   FontManager font_manager;
+  Sampler sampler(&light_sensors[0], sensor_count);
+  FlickerAnalyzer flicker_analyzer;
+  Calibrator calibrator;
+  CalibrationStore calibration_store;
   
   stdio_init_all();
 
@@ -60,17 +227,108 @@ int main() {
   gpio_pull_up(PICO_DEFAULT_I2C_SCL_PIN);
 
   display.init();
-  light_sensor.init();
+  for (size_t index = 0; index < sensor_count; ++index) {
+    CalibrationProfile profile;
+    if (calibration_store.load(index, profile) && !light_sensors[index].setCalibration(profile)) {
+      printf("Stored calibration for sensor %u rejected, a gain is out of range\n", 
+             static_cast<unsigned>(index));
+    }
+    light_sensors[index].init();
+  }
+  light_sensor.start();
+  Mode mode = Mode::watch;
+  bool watching = false;
+  auto next_check_time = make_timeout_time_ms(reading_period_ms);
     
 loop:
-  light_sensor.read();
-  auto lux = light_sensor.getAmbientLightLux();
-  display.draw(lux, 0);  
-  auto white_channel = light_sensor.getWhiteChannel();
-  display.draw(white_channel, 1);
+  switch (getchar_timeout_us(0)) {
+  case watch_command:
+    if (mode != Mode::watch) {
+      mode = Mode::watch;
+      watching = false;
+      light_sensor.setMaximumIntegrationTime(AlsConfigRegister::ms_800);
+      light_sensor.start();
+    }
+    break;
+  case sample_command:
+    if (mode != Mode::sample) {
+      mode = Mode::sample;
+      sampler.start();
+      next_check_time = make_timeout_time_ms(reading_period_ms);
+    }
+    break;
+  case flicker_command:
+    if (mode != Mode::flicker) {
+      mode = Mode::flicker;
+      light_sensor.setMaximumIntegrationTime(AlsConfigRegister::ms_25);
+      flicker_analyzer.reset();
+      light_sensor.start();
+    }
+    break;
+  case export_command:
+    exportSamples(sampler);
+    break;
+  case calibrate_command: {
+    char line[command_line_size];
+    if (readCommandLine(line, sizeof(line))) {
+      calibrate(line, light_sensors, calibrator, calibration_store);
+    }
+    break;
+  }
+  }
+
+  switch (mode) {
+  case Mode::watch:
+    light_sensor.poll();
+    if (light_sensor.ready() && !watching) {
+      auto lux = light_sensor.getAmbientLightLux();
+      display.draw(lux, 0);  
+      auto white_channel = light_sensor.getWhiteChannel();
+      display.draw(white_channel, 1);
+      printf("Worst case poll time: %lld us, register accesses: %lu\n", 
+             light_sensor.getWorstCasePollTime(), light_sensor.getRegisterAccessCount());
+      
+      light_sensor.watch(watch_band_percent);
+      watching = true;
+      next_check_time = make_timeout_time_ms(reading_period_ms);
+    } else if (watching && time_reached(next_check_time)) {
+      if (light_sensor.thresholdCrossed()) {
+        light_sensor.start();
+        watching = false;
+      } 
+      next_check_time = make_timeout_time_ms(reading_period_ms);
+    }
+    break;
+    
+  case Mode::sample:
+    sampler.poll();
+    if (time_reached(next_check_time) && sampler.getSamples().size() > 0) {
+      auto& statistics = sampler.getStatistics();
+      display.draw(statistics.getMedian(), 0);
+      display.draw(sampler.getSamples().newest().whiteChannel, 1);
+      display.draw(statistics.getMean(), 2);
+      next_check_time = make_timeout_time_ms(reading_period_ms);
+    }
+    break;
+    
+  case Mode::flicker:
+    light_sensor.poll();
+    if (light_sensor.ready()) {
+      flicker_analyzer.add(light_sensor.getScaledAmbientLightLux(), 
+                           to_ms_since_boot(get_absolute_time()));
+      if (flicker_analyzer.full()) {
+        if (flicker_analyzer.analyze()) {
+          showFlicker(flicker_analyzer, display);
+        }
+        flicker_analyzer.reset();
+      }
+      light_sensor.start();
+    }
+    break;
+  }
   
-  sleep_ms(1500);
+  tight_loop_contents();
   goto loop;
 
   return 0;
-}
\ No newline at end of file
+}
@@ -37,7 +37,6 @@
 #include "LightSensor.h"
 #include "AlsConfigRegister.h"
 
-#include "hardware/i2c.h"
 #include "pico/time.h"
 #include <algorithm>
 #include <cstdint>
@@ -48,103 +47,349 @@ constexpr uint8_t address = 0x10;
 //
 // LUX correction constants
 //
-const float c4 = 6.0135E-13;
-const float c3 = -9.3924E-9;
-const float c2 = 8.1488E-5;
-const float c1 = 1.0023;
+constexpr double c4 = 6.0135E-13;
+constexpr double c3 = -9.3924E-9;
+constexpr double c2 = 8.1488E-5;
+constexpr double c1 = 1.0023;
+
+constexpr int64_t toFixedPoint(double value, int fraction_bits) {
+  for (int bit = 0; bit < fraction_bits; ++bit) {
+    value *= 2;
+  }
+  return static_cast<int64_t>(value < 0 ? value - 0.5 : value + 0.5);
+}
+
+// The correction constants in fixed point for Horner's method. Each has the fraction
+// bits needed for its term, with lux in Q8 the products stay within 64 bits.
+constexpr int64_t c4_q64 = toFixedPoint(c4, 64);
+constexpr int64_t c3_q56 = toFixedPoint(c3, 56);
+constexpr int64_t c2_q48 = toFixedPoint(c2, 48);
+constexpr int64_t c1_q32 = toFixedPoint(c1, 32);
 
 //
 // Command codes
 //
 constexpr uint8_t als_config_command_code = 0x00;
+constexpr uint8_t high_threshold_command_code = 0x01;
+constexpr uint8_t low_threshold_command_code = 0x02;
+constexpr uint8_t power_saving_command_code = 0x03;
 constexpr uint8_t ambient_light_command_code = 0x04;
 constexpr uint8_t white_channel_command_code = 0x05;
+constexpr uint8_t interrupt_status_command_code = 0x06;
 
 //
 // ALS Constants
 //
+constexpr uint16_t als_count_minimum = 100;
 constexpr uint16_t als_count_limit = 10000;
-// LUX multiplier. Ordered by integration time then gain.
-const float lux_multipliers[6][4] = {
-  {2.1504, 1.0752, 0.2688, 0.1344},
-  {1.0752, 0.5376, 0.1344, 0.0672},
-  {0.5376, 0.2688, 0.0672, 0.0336},
-  {0.2688, 0.1344, 0.0336, 0.0168},
-  {0.1344, 0.0672, 0.0168, 0.0084}, 
-  {0.0672, 0.0336, 0.0084, 0.0042}
+// LUX multiplier scaled by the lux scale. Ordered by integration time then gain.
+constexpr uint32_t lux_multipliers[6][4] = {
+  {21504, 10752, 2688, 1344},
+  {10752,  5376, 1344,  672},
+  { 5376,  2688,  672,  336},
+  { 2688,  1344,  336,  168},
+  { 1344,   672,  168,   84}, 
+  {  672,   336,   84,   42}
 };
-const uint32_t integration_times[] = {25, 50, 100, 200, 400, 800}; //ms
-const float gain_values[] = {0.125, 0.25, 1, 2};
+constexpr uint32_t integration_times[] = {25, 50, 100, 200, 400, 800}; //ms
+// The most lux read, at the count limit at 1/8 gain and 25 ms.
+constexpr uint32_t maximum_uncalibrated_lux = als_count_limit * lux_multipliers[0][0];
+// Gains of 1/8, 1/4, 1 and 2 as powers of two of the 1/8 gain.
+constexpr int gain_shifts[] = {0, 1, 3, 4};
+// Integration times double with each step, so sensitivity is a power of two of the 
+// least sensitive setting, 1/8 gain and 25 ms.
+constexpr int sensitivityShift(int time_index, int gain_index) {
+  return time_index + gain_shifts[gain_index];
+}
+// White channel counts/ms at the least sensitive setting scaled by the lux scale.
+constexpr uint32_t white_channel_multiplier = (8 * LightMeter::LightSensor::lux_scale) / 25;
+// Above 1000 lux the lux is corrected for non-linearity.
+constexpr uint32_t correction_threshold = 1000 * LightMeter::LightSensor::lux_scale;
+
+constexpr bool checkLuxMultipliers() {
+  for (int time = 0; time < 6; ++time) {
+    for (int gain = 0; gain < 4; ++gain) {
+      if (lux_multipliers[time][gain] != (lux_multipliers[0][0] >> sensitivityShift(time, gain))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+static_assert(checkLuxMultipliers(), "LUX multipliers must halve with each sensitivity step.");
 
 using namespace LightMeter;
 
+///
+/// \brief Predict the gain and integration time that bring the counts into range.
+///
+/// \details The lux multipliers scale counts to lux, so the counts expected with another
+///   setting are the lux from the current counts divided by that setting's multiplier.
+///   The shortest integration time, and for it the highest gain, expected to give counts 
+///   between the minimum and the limit is chosen. When no setting is expected to, the most
+///   sensitive setting is chosen for low light and the least sensitive for bright light.
+///   Integration times longer than the maximum are not considered.
+///
+/// \param counts The ambient light sensor counts read with the configuration register.
+/// \param maximum_time The longest integration time to choose.
+/// \param config_register The configuration register to update with the prediction.
+///
+static void predictSetting(uint16_t counts, AlsConfigRegister::IntegrationTime maximum_time,
+                           AlsConfigRegister& config_register) 
+{
+  int time_index = config_register.getIntegrationTime();
+  int gain_index = config_register.getGain();
+  uint32_t lux = counts * lux_multipliers[time_index][gain_index];
+
+  for (int time = AlsConfigRegister::ms_25; time <= maximum_time; ++time) {
+    for (int gain = AlsConfigRegister::high; gain >= AlsConfigRegister::low; --gain) {
+      uint32_t multiplier = lux_multipliers[time][gain];
+      if (lux >= als_count_minimum * multiplier && lux <= als_count_limit * multiplier) {
+        config_register.setIntegrationTime(AlsConfigRegister::IntegrationTime(time));
+        config_register.setGain(AlsConfigRegister::Gain(gain));
+        return;
+      }
+    }
+  }
+  
+  bool too_dark = lux < als_count_minimum * lux_multipliers[maximum_time][AlsConfigRegister::high];
+  config_register.setIntegrationTime(too_dark ? maximum_time : AlsConfigRegister::ms_25);
+  config_register.setGain(too_dark ? AlsConfigRegister::high : AlsConfigRegister::low);
+}
+
+///
+/// \brief The correction factor of a calibration curve at a lux.
+///
+/// \details Interpolates linearly between the curve's points, holding the first and last
+///   points' factors beyond them.
+///
+/// \param profile The calibration with at least one curve point.
+/// \param lux The calibrated lux before correction, scaled by the lux scale.
+/// \return The correction factor in Q16.
+///
+static int32_t curveFactor(const CalibrationProfile& profile, uint64_t lux) {
+  auto& first = profile.curve[0];
+  if (lux <= first.lux) {
+    return first.factor;
+  }
+  for (uint32_t index = 1; index < profile.curvePointCount; ++index) {
+    auto& lower = profile.curve[index - 1];
+    auto& upper = profile.curve[index];
+    if (lux <= upper.lux) {
+      int64_t span = upper.lux - lower.lux;
+      int64_t offset = lux - lower.lux;
+      return lower.factor + ((upper.factor - lower.factor) * offset) / span;
+    }
+  }
+  return profile.curve[profile.curvePointCount - 1].factor;
+}
+
 //
 // Public Interface
 //
-void LightSensor::init() {
-  AlsConfigRegister config_register;
-  config_register.setting.power = AlsConfigRegister::on;
-  writeConfigRegister(config_register);
-  
-  sleep_ms(3);
+LightSensor::LightSensor() {
+  setCalibration(CalibrationProfile());
 }
 
-void LightSensor::read() {
-  AlsConfigRegister config_register = readConfigRegister();
+LightSensor::LightSensor(SensorBus bus) : bus(bus) {
+  setCalibration(CalibrationProfile());
+}
 
-  uint16_t counts = readAmbientLightRegister();
+void LightSensor::init() {
+  configRegister = AlsConfigRegister();
+  powerOn(configRegister);
+}
 
-  while (counts < 100 && config_register.getIntegrationTime() != AlsConfigRegister::ms_800) 
-  {       
-    shutdown(config_register);
-    
-    if (config_register.getGain() != AlsConfigRegister::high) {
-      config_register.increaseGain();
-      writeConfigRegister(config_register);
-    } else if (config_register.getIntegrationTime() != AlsConfigRegister::ms_800) {
-      config_register.increaseIntegrationTime();
-      writeConfigRegister(config_register);
-    }
-    
-    powerOn(config_register);
-    counts = readAmbientLightRegister();
+void LightSensor::start() {
+  if (configRegister.setting.interupt_enable == AlsConfigRegister::enable) {
+    configRegister.setting.interupt_enable = AlsConfigRegister::disable;
+    writeConfigRegister(configRegister);
+    writePowerSavingRegister(PowerSavingRegister());
+    integrationDeadline = make_timeout_time_ms(integrationDelay(configRegister));
   }
+  state = integrating;
+}
 
-  while (counts > als_count_limit &&
-         config_register.getIntegrationTime() != AlsConfigRegister::ms_25) 
-  {
-    shutdown(config_register);
-    config_register.decreaseIntegrationTime();
-    writeConfigRegister(config_register);
-    powerOn(config_register);
-    
-    counts = readAmbientLightRegister();
+void LightSensor::poll() {
+  auto poll_start = get_absolute_time();
+  step();
+  auto poll_time = absolute_time_diff_us(poll_start, get_absolute_time());
+  worstCasePollTime = std::max(worstCasePollTime, poll_time);
+}
+
+void LightSensor::watch(uint8_t band_percent, PowerSavingRegister::Mode mode) {
+  uint32_t band = (static_cast<uint32_t>(countsWhenRead) * band_percent) / 100;
+  uint16_t low_threshold = countsWhenRead - std::min<uint32_t>(band, countsWhenRead);
+  uint16_t high_threshold = std::min<uint32_t>(countsWhenRead + band, UINT16_MAX);
+  writeThresholdRegisters(low_threshold, high_threshold);
+  
+  PowerSavingRegister power_saving_register;
+  power_saving_register.setting.enable = PowerSavingRegister::enable;
+  power_saving_register.setting.mode = mode;
+  writePowerSavingRegister(power_saving_register);
+  
+  configRegister.setting.interupt_enable = AlsConfigRegister::enable;
+  writeConfigRegister(configRegister);
+  
+  // Clear flags left over from before the thresholds were set.
+  readInterruptStatusRegister();
+}
+
+bool LightSensor::thresholdCrossed() {
+  auto status_register = readInterruptStatusRegister();
+  return status_register.setting.threshold_low || status_register.setting.threshold_high;
+}
+
+///
+/// \brief Set the calibration applied to readings.
+///
+/// \details Each range's gain is folded into the lux multipliers of its gain setting, and
+///   a correction curve is sampled at even steps of lux, so a reading takes a multiply
+///   and a lookup whatever the profile.
+///
+/// \param profile The calibration, with positive gains and curve points ordered by lux.
+/// \return False, with the calibration unchanged, if a gain is not positive or would 
+///   overflow its lux multipliers.
+///
+bool LightSensor::setCalibration(const CalibrationProfile& profile) {
+  // The first integration time has the largest multipliers.
+  for (int gain = AlsConfigRegister::low; gain <= AlsConfigRegister::high; ++gain) {
+    if (profile.gains[gain] <= 0 || static_cast<uint64_t>(lux_multipliers[0][gain]) 
+        * static_cast<uint64_t>(profile.gains[gain]) > UINT32_MAX) {
+      return false;
+    }
   }
   
-  gainWhenRead = config_register.getGain();
-  integrationTimeWhenRead = config_register.getIntegrationTime();
-  setAmbientLightLux(readAmbientLightRegister());
-  setWhiteChannel(readWhiteChannelRegister());
+  calibration = profile;
+  calibration.curvePointCount = std::min<uint32_t>(profile.curvePointCount,
+                                                   CalibrationProfile::maximum_curve_points);
   
-  // restore the gain and integration times to 1/8 and 100 ms.
-  shutdown(config_register);
-  config_register.setGain(AlsConfigRegister::low);
-  config_register.setIntegrationTime(AlsConfigRegister::ms_100);
-  writeConfigRegister(config_register);
-  powerOn(config_register);
+  for (int time = AlsConfigRegister::ms_25; time <= AlsConfigRegister::ms_800; ++time) {
+    for (int gain = AlsConfigRegister::low; gain <= AlsConfigRegister::high; ++gain) {
+      calibratedMultipliers[time][gain] = lux_multipliers[time][gain] 
+        * static_cast<uint32_t>(calibration.gains[gain]);
+    }
+  }
+  
+  for (size_t step = 0; step <= correction_step_count; ++step) {
+    uint64_t lux = static_cast<uint64_t>(step) << correction_step_shift;
+    correctionFactors[step] = calibration.curvePointCount == 0 ? CalibrationProfile::unity_gain
+      : std::max<int32_t>(curveFactor(calibration, lux), 0);
+  }
+  return true;
+}
+
+bool LightSensor::isNonLinear(uint32_t lux, AlsConfigRegister::Gain gain) {
+  return lux > correction_threshold && gain < AlsConfigRegister::medium_high;
 }
 
 //
 // Private Interface
 //
 
+///
+/// \brief Advance the reading state machine by at most one integration.
+///
+/// \details Nothing is done until the integration deadline of the current configuration
+///  has passed. Then if the ambient light counts are out of range the gain and integration
+///  time expected to bring them into range are predicted, and the sensor is restarted with
+///  them and a new deadline. The next poll continues from there. Saturated counts can 
+///  under predict, so this may take more than one step in very bright light.
+///
+void LightSensor::step() {
+  if (state == idle || !time_reached(integrationDeadline)) {
+    return;
+  }
+
+  uint16_t counts = readAmbientLightRegister();
+  
+  AlsConfigRegister predicted_register = configRegister;
+  predictSetting(counts, maximumIntegrationTime, predicted_register);
+  bool out_of_range = counts < als_count_minimum || counts > als_count_limit 
+    || configRegister.getIntegrationTime() > maximumIntegrationTime;
+  
+  if (out_of_range && predicted_register.value != configRegister.value) {
+    shutdown(configRegister);
+    configRegister = predicted_register;
+    writeConfigRegister(configRegister);
+    powerOn(configRegister);
+  } else {
+    finish(counts);
+  }
+}
+
+///
+/// \brief Completes a reading with the ambient light counts.
+///
+/// \details Records the lux and white channel values. The gain and integration time are
+///   kept for the next reading, which will start from them once the next integration 
+///   has completed.
+///
+/// \param counts The ambient light sensor counts.
+///
+void LightSensor::finish(uint16_t counts) {
+  gainWhenRead = configRegister.getGain();
+  integrationTimeWhenRead = configRegister.getIntegrationTime();
+  countsWhenRead = counts;
+  setAmbientLightLux(counts);
+  setWhiteChannel(readWhiteChannelRegister());
+  
+  integrationDeadline = make_timeout_time_ms(integrationDelay(configRegister));
+  state = idle;
+}
+
+///
+/// \brief Correct lux for the sensor's non-linearity.
+///
+/// \details Evaluates the fourth order polynomial with Horner's method in integer math.
+///   The lux is taken to Q8 for the inner terms, each product is shifted back to the
+///   fraction bits of the next constant, and the last product is with the scaled lux.
+///
+/// \param lux The uncalibrated lux scaled by the lux scale, 10,000 counts at 1/8 gain
+///   and 25 ms at most.
+/// \return The corrected lux scaled by the lux scale.
+///
+static uint32_t correctLux(uint32_t lux) {
+  lux = std::min(lux, maximum_uncalibrated_lux);
+  // The lux in Q8 is lux * 256 / 10000.
+  static_assert(LightSensor::lux_scale == 10000);
+  int64_t lux_q8 = (static_cast<int64_t>(lux) * 16) / 625;
+  int64_t term = ((c4_q64 * lux_q8) >> 16) + c3_q56;
+  term = ((term * lux_q8) >> 16) + c2_q48;
+  term = ((term * lux_q8) >> 24) + c1_q32;
+  return static_cast<uint32_t>((term * static_cast<int64_t>(lux)) >> 32);
+}
+
+///
+/// \brief Correct lux with the calibration's curve.
+///
+/// \details Interpolates between the correction factors either side of the lux.
+///
+/// \param lux The calibrated lux scaled by the lux scale.
+/// \return The corrected lux scaled by the lux scale.
+///
+uint32_t LightSensor::correctWithCurve(uint32_t lux) const {
+  size_t step = lux >> correction_step_shift;
+  int64_t factor = correctionFactors[correction_step_count];
+  if (step < correction_step_count) {
+    int64_t lower = correctionFactors[step];
+    int64_t upper = correctionFactors[step + 1];
+    int64_t fraction = lux & ((1u << correction_step_shift) - 1);
+    factor = lower + (((upper - lower) * fraction) >> correction_step_shift);
+  }
+  uint64_t corrected = (static_cast<uint64_t>(lux) * factor) >> CalibrationProfile::gain_fraction_bits;
+  return std::min<uint64_t>(corrected, UINT32_MAX);
+}
+
 ///
 /// \brief Set the ambient light lux value with the channel count.
 ///
 /// \details Calculates the lux value by multiplying adjusted for gain and integration
-///  time. If the value is over 1000 lux the value is adjusted by a fourth order
-///  polynomial for non-linearity in the sensor. Above 10,000 counts the sensor is 
-///  consider very non-linear, so the value is clamped to this value.
+///  time, with the calibration's gain and offset for the gain setting. If the value is
+///  over 1000 lux at a low gain the value is adjusted for non-linearity in the sensor,
+///  by the calibration's curve or otherwise a fourth order polynomial. Above 10,000 
+///  counts the sensor is consider very non-linear, so the value is clamped to this
+///  value. The value is fixed point, scaled by the lux scale.
 ///
 /// \params counts The ambient light sensor counts.
 ///
@@ -155,10 +400,22 @@ void LightSensor::setAmbientLightLux(uint16_t counts) {
   
   int time_index =  integrationTimeWhenRead;
   int gain_index = gainWhenRead;
-  float multiplier = lux_multipliers[time_index][gain_index];
-  float lux = counts * multiplier;
-  if (lux > 1000.0 && getGainWhenRead() < AlsConfigRegister::medium_high) {
-    lux = (((c4 * lux + c3) * lux + c2) * lux + c1) * lux;
+  uncalibratedLux = counts * lux_multipliers[time_index][gain_index];
+  
+  int64_t calibrated_lux = (static_cast<uint64_t>(counts) * calibratedMultipliers[time_index][gain_index])
+    >> CalibrationProfile::gain_fraction_bits;
+  calibrated_lux = std::max<int64_t>(calibrated_lux + calibration.offsets[gain_index], 0);
+  uint32_t lux = std::min<int64_t>(calibrated_lux, UINT32_MAX);
+  if (isNonLinear(uncalibratedLux, gainWhenRead)) {
+    if (calibration.curvePointCount > 0) {
+      lux = correctWithCurve(lux);
+    } else {
+      // The polynomial is the datasheet's, so it is taken at the uncalibrated lux, within
+      // its range whatever the calibration's gain, and applied as a factor.
+      uint64_t corrected = static_cast<uint64_t>(lux) * correctLux(uncalibratedLux) 
+        / uncalibratedLux;
+      lux = std::min<uint64_t>(corrected, UINT32_MAX);
+    }
   }
   ambientLightLux = lux;
 }
@@ -167,22 +424,35 @@ void LightSensor::setAmbientLightLux(uint16_t counts) {
 /// \brief Set the white channel value.
 ///
 /// \details Set the white channel value from the counts normalizing it for the gain and 
-/// integration time when the register was read. The value is in counts/ms.
+/// integration time when the register was read. The value is in counts/ms, fixed point 
+/// scaled by the lux scale.
 ///
 /// \param count The white channel count.
 /// 
 void LightSensor::setWhiteChannel(uint16_t count) {
-  float time = static_cast<float>(integration_times[getIntegrationTimeWhenRead()]);
-  float gain = gain_values[getGainWhenRead()];
-  whiteChannel = static_cast<float>(count) / (gain * time);
+  int shift = sensitivityShift(getIntegrationTimeWhenRead(), getGainWhenRead());
+  whiteChannel = (count * white_channel_multiplier) >> shift;
 }
 
+///
+/// \brief Power on the sensor and set the deadline for its first integration.
+///
+/// \details The sensor is not waited on, poll() checks the deadline instead.
+///
 void LightSensor::powerOn(AlsConfigRegister& config_register) {
   config_register.setting.power = AlsConfigRegister::on;
   writeConfigRegister(config_register);
+  integrationDeadline = make_timeout_time_ms(integrationDelay(config_register));
+}
+
+///
+/// \brief The time for an integration's counts to be available in milliseconds.
+///
+/// \details Allows 18% more than the integration time of the configuration.
+///
+uint32_t LightSensor::integrationDelay(AlsConfigRegister& config_register) {
   uint32_t integration_time = integration_times[config_register.getIntegrationTime()];
-  uint32_t delay_time = integration_time + (integration_time * 18)/100;
-  sleep_ms(delay_time);
+  return integration_time + (integration_time * 18)/100;
 }
 
 void LightSensor::shutdown(AlsConfigRegister& config_register) {
@@ -199,6 +469,20 @@ void LightSensor::writeConfigRegister(AlsConfigRegister config_register) {
   writeRegister(als_config_command_code, Register(config_register.value));
 }
 
+void LightSensor::writePowerSavingRegister(PowerSavingRegister power_saving_register) {
+  writeRegister(power_saving_command_code, Register(power_saving_register.value));
+}
+
+void LightSensor::writeThresholdRegisters(uint16_t low_threshold, uint16_t high_threshold) {
+  writeRegister(low_threshold_command_code, Register(low_threshold));
+  writeRegister(high_threshold_command_code, Register(high_threshold));
+}
+
+InterruptStatusRegister LightSensor::readInterruptStatusRegister() {
+  Register reg = readRegister(interrupt_status_command_code);
+  return InterruptStatusRegister(reg.value);
+}
+
 uint16_t LightSensor::readAmbientLightRegister() {
   Register reg = readRegister(ambient_light_command_code);
   return reg.value;
@@ -211,8 +495,9 @@ uint16_t LightSensor::readWhiteChannelRegister() {
 
 LightSensor::Register LightSensor::readRegister(CommandCode command_code) {
   uint8_t buffer[2];
-  i2c_write_blocking(i2c_default, address, &command_code, 1, true);
-  i2c_read_blocking(i2c_default, address, &buffer[0], 2, false);
+  bus.write(address, &command_code, 1, true);
+  bus.read(address, &buffer[0], 2);
+  ++registerAccessCount;
   
   Register reg;
   reg.data_byte.lsb = buffer[0];
@@ -222,5 +507,6 @@ LightSensor::Register LightSensor::readRegister(CommandCode command_code) {
 
 void LightSensor::writeRegister(CommandCode command_code, Register reg) {
   uint8_t buffer[] = {command_code, reg.data_byte.lsb, reg.data_byte.msb};
-  i2c_write_blocking(i2c_default, address, &buffer[0], 3, false);
+  bus.write(address, &buffer[0], 3);
+  ++registerAccessCount;
 }
\ No newline at end of file
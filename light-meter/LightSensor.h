@@ -37,7 +37,11 @@
 
 #include <cstdint>
 
+#include "pico/time.h"
+
 #include "AlsConfigRegister.h"
+#include "CalibrationProfile.h"
+#include "SensorBus.h"
 
 namespace LightMeter {
 
@@ -45,24 +49,93 @@ typedef uint8_t CommandCode;
 
 class LightSensor {
 public:
-  LightSensor() = default;
+  /*
+   * The lux and white channel are fixed point values in units of 1/lux_scale.
+   */
+  static constexpr uint32_t lux_scale = 10000;
+
+  LightSensor();
+  /*
+   * A sensor on a bus handle, which allows several sensors with the same address
+   * behind a multiplexer.
+   */
+  LightSensor(SensorBus bus);
   ~LightSensor() = default;
   
   void init();
   /*
-   * Read the ambient light register and calculate the lux. Plus, read the white
-   * channel register.
+   * Start a reading of the ambient light and white channel registers. The reading
+   * is carried out by subsequent calls to poll().
+   */
+  void start();
+  /*
+   * Advance the reading without blocking. Register accesses are only made once the
+   * sensor's integration deadline has passed, predicting the gain and integration
+   * time as needed, then the lux and white channel values are calculated.
    */
-  void read();
+  void poll();
+  /*
+   * True once the reading started by start() has completed.
+   */
+  bool ready() const { return state == idle; }
+  /*
+   * Watch for the ambient light leaving a band around the last reading. The band is
+   * a percentage of the reading's counts, set in the threshold registers with the 
+   * interrupt and power saving mode enabled. The next start() disables them.
+   */
+  void watch(uint8_t band_percent, PowerSavingRegister::Mode mode = PowerSavingRegister::mode_2);
+  /*
+   * True if the ambient light crossed the band set by watch(). This is a single
+   * register read, which also clears the interrupt flags.
+   */
+  bool thresholdCrossed();
 
-  float getAmbientLightLux() { return ambientLightLux; }
-  float getWhiteChannel() { return whiteChannel; }
-  AlsConfigRegister::Gain getGainWhenRead() { return gainWhenRead; }
-  AlsConfigRegister::IntegrationTime getIntegrationTimeWhenRead() { 
+  /*
+   * Apply a calibration profile to subsequent readings. The profile is folded into
+   * tables here, so applying it costs a table lookup per reading. Returns false, keeping
+   * the calibration as it was, if a range's gain is not positive or too large for its
+   * multipliers.
+   */
+  bool setCalibration(const CalibrationProfile& profile);
+  const CalibrationProfile& getCalibration() const { return calibration; }
+  /*
+   * True if lux read at the gain is in the sensor's non-linear region, where it is
+   * corrected by the calibration's curve or the datasheet polynomial.
+   */
+  static bool isNonLinear(uint32_t lux, AlsConfigRegister::Gain gain);
+
+  uint32_t getScaledAmbientLightLux() const { return ambientLightLux; }
+  /*
+   * The lux of the last reading from the datasheet multipliers alone, before
+   * calibration and correction, scaled by the lux scale.
+   */
+  uint32_t getUncalibratedLux() const { return uncalibratedLux; }
+  uint32_t getScaledWhiteChannel() const { return whiteChannel; }
+  float getAmbientLightLux() { return static_cast<float>(ambientLightLux) / lux_scale; }
+  float getWhiteChannel() { return static_cast<float>(whiteChannel) / lux_scale; }
+  AlsConfigRegister::Gain getGainWhenRead() const { return gainWhenRead; }
+  AlsConfigRegister::IntegrationTime getIntegrationTimeWhenRead() const { 
     return integrationTimeWhenRead; 
   }
+  /*
+   * Limit the integration times autoranging chooses from. Shorter integration times
+   * allow faster readings, in exchange for sensitivity in low light. 
+   */
+  void setMaximumIntegrationTime(AlsConfigRegister::IntegrationTime time) {
+    maximumIntegrationTime = time;
+  }
+  /*
+   * The longest time spent in a single call to poll() in microseconds.
+   */
+  int64_t getWorstCasePollTime() const { return worstCasePollTime; }
+  /*
+   * The number of register reads and writes made over the I2C bus.
+   */
+  uint32_t getRegisterAccessCount() const { return registerAccessCount; }
   
 private:
+  enum State { idle, integrating };
+
   struct Register {
     union {
       uint16_t value;
@@ -75,20 +148,46 @@ private:
     Register(uint16_t value) : value(value) {}
   };
   
-  float ambientLightLux = 0;
-  float whiteChannel = 0;
+  uint32_t ambientLightLux = 0;
+  uint32_t whiteChannel = 0;
+  uint32_t uncalibratedLux = 0;
   AlsConfigRegister::Gain gainWhenRead;
   AlsConfigRegister::IntegrationTime integrationTimeWhenRead;
   
+  SensorBus bus;
+  State state = idle;
+  AlsConfigRegister::IntegrationTime maximumIntegrationTime = AlsConfigRegister::ms_800;
+  AlsConfigRegister configRegister;
+  absolute_time_t integrationDeadline;
+  int64_t worstCasePollTime = 0;
+  uint16_t countsWhenRead = 0;
+  uint32_t registerAccessCount = 0;
+  
+  // The calibration and the tables it is applied through. The multipliers are the 
+  // datasheet's with the range gains folded in, in Q16, and the correction factors
+  // are the curve sampled at even steps of lux.
+  static constexpr int correction_step_shift = 23;
+  static constexpr size_t correction_step_count = 32;
+  CalibrationProfile calibration;
+  uint32_t calibratedMultipliers[6][CalibrationProfile::range_count];
+  uint32_t correctionFactors[correction_step_count + 1];
+  
+  void step();
+  void finish(uint16_t);
   
   void setAmbientLightLux(uint16_t);
   void setWhiteChannel(uint16_t);
+  uint32_t correctWithCurve(uint32_t) const;
 
   void powerOn(AlsConfigRegister&);
   void shutdown(AlsConfigRegister&);
+  static uint32_t integrationDelay(AlsConfigRegister&);
   
   AlsConfigRegister readConfigRegister();
   void writeConfigRegister(AlsConfigRegister);
+  void writePowerSavingRegister(PowerSavingRegister);
+  void writeThresholdRegisters(uint16_t, uint16_t);
+  InterruptStatusRegister readInterruptStatusRegister();
   
   uint16_t readAmbientLightRegister();
   uint16_t readWhiteChannelRegister();
@@ -0,0 +1,84 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <cstddef>
+
+namespace LightMeter {
+
+//
+// Fixed capacity ring buffer. Once full, each push overwrites the oldest element.
+//
+template <typename Element, size_t Capacity>
+class RingBuffer {
+public:
+  RingBuffer() = default;
+  ~RingBuffer() = default;
+  
+  void push(const Element& element) {
+    elements[next] = element;
+    next = (next + 1) % Capacity;
+    if (count < Capacity) {
+      ++count;
+    }
+  }
+  
+  void clear() { 
+    next = 0;
+    count = 0;
+  }
+  
+  size_t size() const { return count; }
+  static constexpr size_t capacity() { return Capacity; }
+  
+  //
+  // Access an element by age, where index 0 is the oldest element.
+  //
+  const Element& operator[](size_t index) const {
+    return elements[(next + Capacity - count + index) % Capacity];
+  }
+  
+  const Element& newest() const { return elements[(next + Capacity - 1) % Capacity]; }
+  
+private:
+  Element elements[Capacity];
+  size_t next = 0;
+  size_t count = 0;
+}; // class RingBuffer
+
+}; // namespace LightMeter
+
+#endif // RINGBUFFER_H
@@ -0,0 +1,86 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "Sampler.h"
+
+#include "pico/time.h"
+
+#include <algorithm>
+
+using namespace LightMeter;
+
+Sampler::Sampler(LightSensor* sensors, size_t sensor_count) 
+  : sensorCount(std::min(sensor_count, maximum_sensors)) 
+{
+  for (size_t index = 0; index < sensorCount; ++index) {
+    this->sensors[index] = &sensors[index];
+  }
+}
+
+void Sampler::start() {
+  samples.clear();
+  for (size_t index = 0; index < sensorCount; ++index) {
+    statistics[index].reset();
+    sensors[index]->setMaximumIntegrationTime(integration_time);
+    sensors[index]->start();
+  }
+}
+
+bool Sampler::poll() {
+  bool sampled = false;
+  
+  for (size_t index = 0; index < sensorCount; ++index) {
+    auto& sensor = *sensors[index];
+    sensor.poll();
+    if (!sensor.ready()) {
+      continue;
+    }
+    
+    Sample sample = {
+      to_ms_since_boot(get_absolute_time()),
+      static_cast<uint8_t>(index),
+      sensor.getAmbientLightLux(),
+      sensor.getWhiteChannel()
+    };
+    samples.push(sample);
+    statistics[index].add(sample.lux);
+    
+    // The sensor keeps its gain, so the next reading is taken as soon as its
+    // integration completes.
+    sensor.start();
+    sampled = true;
+  }
+  
+  return sampled;
+}
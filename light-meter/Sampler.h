@@ -0,0 +1,101 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include <cstdint>
+
+#include "LightSensor.h"
+#include "RingBuffer.h"
+#include "SensorBus.h"
+#include "StreamingStatistics.h"
+
+namespace LightMeter {
+
+//
+// Samples light sensors back to back, as fast as their integration times allow, into
+// a ring buffer of timestamped readings with statistics on the lux for each sensor.
+// The sensors are polled in turn, so while one integrates the others can be read.
+//
+// While sampling, the sensors' integration time is held at the shortest, 25 ms, with
+// only the gain autoranging. Samples then come at an even rate of up to 40 a second
+// and cover the sensor's full range, rather than slowing to 800 ms in low light. The
+// cost is resolution in low light, 0.07 lux a count at the highest gain.
+//
+class Sampler {
+public:
+  struct Sample {
+    /// \brief Time of the reading in milliseconds since boot.
+    uint32_t timestamp;
+    /// \brief Index of the sensor read.
+    uint8_t sensor;
+    float lux;
+    float whiteChannel;
+  };
+  
+  static constexpr size_t sample_capacity = 256;
+  static constexpr size_t maximum_sensors = I2cMultiplexer::channel_count;
+  static constexpr auto integration_time = AlsConfigRegister::ms_25;
+  
+  Sampler(LightSensor& sensor) : sensors{&sensor}, sensorCount(1) {}
+  Sampler(LightSensor* sensors, size_t sensor_count);
+  ~Sampler() = default;
+  
+  //
+  // Start sampling, clearing the previous samples and statistics. The sensors are held
+  // to the integration time until their maximum integration time is set again.
+  //
+  void start();
+  //
+  // Poll the sensor without blocking. Returns true when a new sample was added.
+  //
+  bool poll();
+  
+  const RingBuffer<Sample, sample_capacity>& getSamples() const { return samples; }
+  const StreamingStatistics& getStatistics(size_t sensor = 0) const { 
+    return statistics[sensor]; 
+  }
+  size_t getSensorCount() const { return sensorCount; }
+  
+private:
+  LightSensor* sensors[maximum_sensors];
+  size_t sensorCount;
+  RingBuffer<Sample, sample_capacity> samples;
+  StreamingStatistics statistics[maximum_sensors];
+}; // class Sampler
+
+}; // namespace LightMeter
+
+#endif // SAMPLER_H
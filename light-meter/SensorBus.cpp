@@ -0,0 +1,63 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "SensorBus.h"
+
+#include "hardware/i2c.h"
+
+using namespace LightMeter;
+
+void I2cMultiplexer::select(uint8_t channel) {
+  if (channel == selectedChannel) {
+    return;
+  }
+  
+  uint8_t channel_mask = 1 << channel;
+  i2c_write_blocking(i2c_default, address, &channel_mask, 1, false);
+  selectedChannel = channel;
+}
+
+void SensorBus::write(uint8_t address, const uint8_t* source, size_t length, bool no_stop) {
+  if (multiplexer != nullptr) {
+    multiplexer->select(channel);
+  }
+  i2c_write_blocking(i2c_default, address, source, length, no_stop);
+}
+
+void SensorBus::read(uint8_t address, uint8_t* destination, size_t length) {
+  if (multiplexer != nullptr) {
+    multiplexer->select(channel);
+  }
+  i2c_read_blocking(i2c_default, address, destination, length, false);
+}
@@ -0,0 +1,86 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#ifndef SENSORBUS_H
+#define SENSORBUS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace LightMeter {
+
+//
+// A TCA9548A style I2C multiplexer, which connects the bus to one of eight channels.
+// The selected channel is remembered so it is only written when it changes.
+//
+class I2cMultiplexer {
+public:
+  static constexpr uint8_t default_address = 0x70;
+  static constexpr uint8_t channel_count = 8;
+  
+  I2cMultiplexer(uint8_t address = default_address) : address(address) {}
+  ~I2cMultiplexer() = default;
+  
+  void select(uint8_t channel);
+  
+private:
+  uint8_t address;
+  int selectedChannel = -1;
+}; // class I2cMultiplexer
+
+//
+// Handle to the I2C bus for a device, either directly on the bus or behind a
+// multiplexer channel. The channel is selected before each transfer.
+//
+class SensorBus {
+public:
+  SensorBus() = default;
+  SensorBus(I2cMultiplexer& multiplexer, uint8_t channel) 
+    : multiplexer(&multiplexer), channel(channel) {}
+  ~SensorBus() = default;
+  
+  //
+  // Write to a device. With no stop the bus is held for a following read.
+  //
+  void write(uint8_t address, const uint8_t* source, size_t length, bool no_stop = false);
+  void read(uint8_t address, uint8_t* destination, size_t length);
+  
+private:
+  I2cMultiplexer* multiplexer = nullptr;
+  uint8_t channel = 0;
+}; // class SensorBus
+
+}; // namespace LightMeter
+
+#endif // SENSORBUS_H
@@ -0,0 +1,84 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "StreamingStatistics.h"
+
+#include <algorithm>
+
+using namespace LightMeter;
+
+void StreamingStatistics::add(float value) {
+  ++count;
+  if (count == 1) {
+    minimum = value;
+    maximum = value;
+    movingAverage = value;
+  } else {
+    minimum = std::min(minimum, value);
+    maximum = std::max(maximum, value);
+    movingAverage += ema_weight * (value - movingAverage);
+  }
+  
+  float delta = value - mean;
+  mean += delta / count;
+  sumOfSquares += delta * (value - mean);
+  
+  recent[nextRecent] = value;
+  nextRecent = (nextRecent + 1) % median_window;
+}
+
+void StreamingStatistics::reset() {
+  *this = StreamingStatistics();
+}
+
+float StreamingStatistics::getVariance() const {
+  return count > 1 ? sumOfSquares / (count - 1) : 0;
+}
+
+float StreamingStatistics::getMedian() const {
+  size_t length = std::min<size_t>(count, median_window);
+  if (length == 0) {
+    return 0;
+  }
+  
+  float sorted[median_window];
+  std::copy(&recent[0], &recent[length], &sorted[0]);
+  std::nth_element(&sorted[0], &sorted[length / 2], &sorted[length]);
+  if (length % 2 == 1) {
+    return sorted[length / 2];
+  }
+  // The lower middle value is the largest of those before the upper.
+  float lower = *std::max_element(&sorted[0], &sorted[length / 2]);
+  return (lower + sorted[length / 2]) / 2;
+}
@@ -0,0 +1,90 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#ifndef STREAMINGSTATISTICS_H
+#define STREAMINGSTATISTICS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace LightMeter {
+
+//
+// Statistics updated in constant time with each value added, without storing the
+// values. The median is over only the last few values.
+//
+class StreamingStatistics {
+public:
+  static constexpr size_t median_window = 5;
+  
+  StreamingStatistics() = default;
+  ~StreamingStatistics() = default;
+  
+  void add(float);
+  void reset();
+  
+  uint32_t getCount() const { return count; }
+  float getMinimum() const { return minimum; }
+  float getMaximum() const { return maximum; }
+  float getMean() const { return mean; }
+  //
+  // Sample variance with Welford's method.
+  //
+  float getVariance() const;
+  //
+  // Exponential moving average weighting each new value by ema_weight.
+  //
+  float getMovingAverage() const { return movingAverage; }
+  //
+  // The median of the last median_window values, the mean of the middle two while
+  // fewer than the window, and an even number, have been added.
+  //
+  float getMedian() const;
+  
+private:
+  static constexpr float ema_weight = 0.1;
+  
+  uint32_t count = 0;
+  float minimum = 0;
+  float maximum = 0;
+  float mean = 0;
+  float sumOfSquares = 0;
+  float movingAverage = 0;
+  float recent[median_window] = {};
+  size_t nextRecent = 0;
+}; // class StreamingStatistics
+
+}; // namespace LightMeter
+
+#endif // STREAMINGSTATISTICS_H
@@ -0,0 +1,33 @@
+# This is based on <PICO_EXTRAS_PATH>/external/pico_extras_import.cmake
+
+# Locates pico-extras when it is available, for optional features such as dormant
+# sleep through hardware_sleep. Unlike pico_extras_import.cmake the build carries on
+# without it, so check for the extras' targets with if(TARGET ...) before using them.
+#
+# pico-extras is found from PICO_EXTRAS_PATH in the environment or cache, or next to
+# the SDK.
+#
+# It should be include()ed prior to project().
+
+if (DEFINED ENV{PICO_EXTRAS_PATH} AND (NOT PICO_EXTRAS_PATH))
+    set(PICO_EXTRAS_PATH $ENV{PICO_EXTRAS_PATH})
+    message("Using PICO_EXTRAS_PATH from environment ('${PICO_EXTRAS_PATH}')")
+endif ()
+
+if (NOT PICO_EXTRAS_PATH AND PICO_SDK_PATH AND EXISTS ${PICO_SDK_PATH}/../pico-extras)
+    set(PICO_EXTRAS_PATH ${PICO_SDK_PATH}/../pico-extras)
+    message("Defaulting PICO_EXTRAS_PATH as sibling of PICO_SDK_PATH: ${PICO_EXTRAS_PATH}")
+endif ()
+
+set(PICO_EXTRAS_PATH "${PICO_EXTRAS_PATH}" CACHE PATH "Path to the PICO EXTRAS")
+
+if (PICO_EXTRAS_PATH)
+    get_filename_component(PICO_EXTRAS_PATH "${PICO_EXTRAS_PATH}" REALPATH BASE_DIR "${CMAKE_BINARY_DIR}")
+    if (EXISTS ${PICO_EXTRAS_PATH}/CMakeLists.txt)
+        add_subdirectory(${PICO_EXTRAS_PATH} pico_extras)
+    else ()
+        message(WARNING "Directory '${PICO_EXTRAS_PATH}' does not appear to contain the PICO EXTRAS")
+    endif ()
+else ()
+    message("PICO_EXTRAS_PATH not set, building without pico-extras")
+endif ()
@@ -0,0 +1,203 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "CommandHandler.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Clock.h"
+#include "ConfigurationStore.h"
+#include "ControlConfiguration.h"
+#include "PowerDevice.h"
+#include "RealTimeClockDevice.h"
+#include "ScheduleCalendar.h"
+#include "SolarCalculator.h"
+#include "TimeScheduler.h"
+
+constexpr size_t configuration_chunk_size = 128;
+constexpr size_t clock_datum_size = 7;
+
+// Configuration writes are staged here until saved.
+static Core::StoredConfiguration stagedConfiguration;
+
+static uint8_t* put16(uint8_t* destination, uint16_t value) {
+  destination[0] = static_cast<uint8_t>(value);
+  destination[1] = static_cast<uint8_t>(value >> 8);
+  return destination + 2;
+}
+
+static uint8_t* put32(uint8_t* destination, uint32_t value) {
+  return put16(put16(destination, static_cast<uint16_t>(value)), static_cast<uint16_t>(value >> 16));
+}
+
+static uint16_t get16(const uint8_t* source) {
+  return source[0] | static_cast<uint16_t>(source[1]) << 8;
+}
+
+static void readClock(const Core::CommandLink::Request& request, Controller& controller) {
+  auto clockDatum = controller.timeDevice.read();
+  uint8_t payload[clock_datum_size] = {
+    clockDatum.time.seconds, clockDatum.time.minutes, clockDatum.time.hour,
+    clockDatum.date.dayOfWeek, clockDatum.date.dayOfMonth, clockDatum.date.month,
+    clockDatum.date.year
+  };
+  controller.link.respond(request, Core::CommandLink::Status::ok, payload, sizeof(payload));
+}
+
+static void writeClock(const Core::CommandLink::Request& request, Controller& controller) {
+  if (request.length != clock_datum_size) {
+    controller.link.respond(request, Core::CommandLink::Status::badLength);
+    return;
+  }
+  auto value = request.payload;
+  Core::ClockDatum clockDatum = {{value[0], value[1], value[2]}, {value[3], value[4], value[5], value[6]}};
+  if (!clockDatum.time.isValid() || !clockDatum.date.isValid()) {
+    controller.link.respond(request, Core::CommandLink::Status::badValue);
+    return;
+  }
+  controller.timeDevice.write(clockDatum);
+  controller.scheduler.reset();
+  controller.link.respond(request, Core::CommandLink::Status::ok);
+}
+
+static void readTelemetry(const Core::CommandLink::Request& request, Controller& controller) {
+  uint8_t payload[23];
+  auto next = put32(payload, controller.readUptimeSeconds());
+  next = put32(next, controller.timeDevice.readTime().inSeconds());
+  next = put32(next, controller.scheduler.getNextTransition());
+  next = put32(next, controller.configurationStore.getSequence());
+  *next++ = static_cast<uint8_t>(controller.configurationStore.getSlot());
+  *next++ = controller.powerDevice.getStatus() == Core::PowerDevice::on ? 1 : 0;
+  *next++ = controller.scheduler.isOverridden() ? 1 : 0;
+  next = put32(next, controller.link.getFrameErrorCount());
+  controller.link.respond(request, Core::CommandLink::Status::ok, payload, next - payload);
+}
+
+static void setPower(const Core::CommandLink::Request& request, Controller& controller) {
+  if (request.length != 1 || request.payload[0] > 2) {
+    controller.link.respond(request, Core::CommandLink::Status::badValue);
+    return;
+  }
+  if (request.payload[0] == 2) {
+    controller.scheduler.clearOverride();
+  } else {
+    controller.scheduler.setOverride(request.payload[0] == 1);
+  }
+  controller.link.respond(request, Core::CommandLink::Status::ok);
+}
+
+static void readConfiguration(const Core::CommandLink::Request& request, Controller& controller) {
+  constexpr size_t size = sizeof(Core::StoredConfiguration);
+  if (request.length != 2 || get16(request.payload) > size) {
+    controller.link.respond(request, Core::CommandLink::Status::badValue);
+    return;
+  }
+  auto offset = get16(request.payload);
+  auto length = std::min(configuration_chunk_size, size - offset);
+  uint8_t payload[4 + configuration_chunk_size];
+  put16(put16(payload, offset), size);
+  std::memcpy(&payload[4], reinterpret_cast<const uint8_t*>(controller.storedConfiguration) + offset, 
+              length);
+  controller.link.respond(request, Core::CommandLink::Status::ok, payload, 4 + length);
+}
+
+static void writeConfiguration(const Core::CommandLink::Request& request, Controller& controller) {
+  if (request.length < 2 || get16(request.payload) + request.length - 2 > sizeof(stagedConfiguration)) {
+    controller.link.respond(request, Core::CommandLink::Status::badLength);
+    return;
+  }
+  std::memcpy(reinterpret_cast<uint8_t*>(&stagedConfiguration) + get16(request.payload), 
+              &request.payload[2], request.length - 2);
+  controller.link.respond(request, Core::CommandLink::Status::ok);
+}
+
+///
+/// \brief Store the staged configuration and schedule from it straight away.
+///
+static void saveConfiguration(const Core::CommandLink::Request& request, Controller& controller) {
+  if (!stagedConfiguration.isValid()) {
+    controller.link.respond(request, Core::CommandLink::Status::badValue);
+    return;
+  }
+  if (!controller.configurationStore.save(stagedConfiguration)) {
+    controller.link.respond(request, Core::CommandLink::Status::failed);
+    return;
+  }
+  
+  auto storedConfiguration = controller.configurationStore.load();
+  controller.storedConfiguration = storedConfiguration;
+  controller.solarCalculator.setLocation(storedConfiguration->latitude, 
+                                         storedConfiguration->longitude,
+                                         storedConfiguration->utcOffsetMinutes);
+  storedConfiguration->apply(controller.configuration, controller.calendar);
+  controller.scheduler.setCalendar(controller.calendar);
+  
+  uint8_t payload[4];
+  put32(payload, controller.configurationStore.getSequence());
+  controller.link.respond(request, Core::CommandLink::Status::ok, payload, sizeof(payload));
+}
+
+void handleRequest(const Core::CommandLink::Request& request, Controller& controller) {
+  switch (static_cast<Command>(request.command)) {
+  case Command::ping:
+    controller.link.respond(request, Core::CommandLink::Status::ok, request.payload, 
+                            request.length);
+    break;
+  case Command::readClock:
+    readClock(request, controller);
+    break;
+  case Command::writeClock:
+    writeClock(request, controller);
+    break;
+  case Command::readTelemetry:
+    readTelemetry(request, controller);
+    break;
+  case Command::setPower:
+    setPower(request, controller);
+    break;
+  case Command::readConfiguration:
+    readConfiguration(request, controller);
+    break;
+  case Command::writeConfiguration:
+    writeConfiguration(request, controller);
+    break;
+  case Command::saveConfiguration:
+    saveConfiguration(request, controller);
+    break;
+  default:
+    controller.link.respond(request, Core::CommandLink::Status::unknownCommand);
+    break;
+  }
+}
@@ -0,0 +1,101 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#pragma once
+
+#include "CommandLink.h"
+
+#include <cstdint>
+
+namespace Core {
+  class ConfigurationStore;
+  struct ControlConfiguration;
+  class PowerDevice;
+  class RealTimeClockDevice;
+  class ScheduleCalendar;
+  class SolarCalculator;
+  class TimeScheduler;
+  struct StoredConfiguration;
+}; // namespace Core
+
+//
+// Commands over USB, framed by the command link. Multi-byte values are little endian.
+//   ping                 any payload, echoed back
+//   readClock            -> second, minute, hour, day of week, day, month, year
+//   writeClock           second, minute, hour, day of week, day, month, year, where the
+//                        day of week is ignored for the date's own
+//   readTelemetry        -> uptime seconds u32, second of day u32, next transition u32,
+//                           configuration sequence u32, configuration slot i8, power
+//                           state u8 (1 on), overridden u8, frame errors u32
+//   setPower             0 off or 1 on until the next transition, 2 back to the schedule
+//   readConfiguration    offset u16 -> offset u16, size u16, up to 128 bytes from the offset
+//   writeConfiguration   offset u16, bytes to stage from the offset
+//   saveConfiguration    store and apply the staged configuration -> sequence u32, or
+//                        badValue if any of its fields is out of range
+// The configuration is the bytes of a Core::StoredConfiguration.
+//
+enum class Command : uint8_t {
+  ping = 0x01,
+  readClock = 0x10,
+  writeClock = 0x11,
+  readTelemetry = 0x20,
+  setPower = 0x30,
+  readConfiguration = 0x40,
+  writeConfiguration = 0x41,
+  saveConfiguration = 0x42
+};
+
+///
+/// \brief What the commands act on.
+///
+struct Controller {
+  Core::RealTimeClockDevice& timeDevice;
+  Core::PowerDevice& powerDevice;
+  Core::TimeScheduler& scheduler;
+  Core::ControlConfiguration& configuration;
+  Core::ScheduleCalendar& calendar;
+  Core::SolarCalculator& solarCalculator;
+  Core::ConfigurationStore& configurationStore;
+  const Core::StoredConfiguration*& storedConfiguration;
+  Core::CommandLink& link;
+  /// \brief The seconds since boot, for telemetry.
+  uint32_t (*readUptimeSeconds)();
+};
+
+///
+/// \brief Act on a request and respond to it.
+/// \description Fields are checked before anything is changed, and a request with one
+///   out of range is answered with an error status and has no effect.
+///
+void handleRequest(const Core::CommandLink::Request& request, Controller& controller);
@@ -34,18 +34,77 @@
 
 #include "PowerDevice.h"
 
+#include "pico/stdio_usb.h"
 #include "pico/stdlib.h"
 #include "pico/time.h"
+#if POWER_CONTROLLER_DORMANT
+#include "pico/sleep.h"
+#endif
 
+#include <algorithm>
 #include <cstdio>
 
 #include "Af128x64FeatherMonoDisplayDevice.h"
 #include "AfDS3231PrecisionRtcDevice.h"
 #include "AfPowerRelayDevice.h"
+#include "CommandHandler.h"
+#include "CommandLink.h"
+#include "ConfigurationStore.h"
 #include "ControlConfiguration.h"
+#include "EventLog.h"
+#include "FlashRegion.h"
+#include "ScheduleCalendar.h"
 #include "SerialBus.h"
+#include "SolarCalculator.h"
+#include "StdioSerialPort.h"
 #include "TimeScheduler.h"
 
+// The event log is kept in the sectors at the end of flash, and the configuration's two
+// slots in the sectors before it.
+constexpr uint32_t event_log_sector_count = 16;
+constexpr uint32_t event_log_offset 
+  = PICO_FLASH_SIZE_BYTES - event_log_sector_count * Core::FlashRegion::sector_size;
+constexpr uint32_t configuration_offset 
+  = event_log_offset - Core::ConfigurationStore::slot_count * Core::FlashRegion::sector_size;
+// Staged event records are programmed when their page fills, or this long after the
+// first of them was appended. This bounds the records lost at a power loss, while power
+// changes, a few a day, still share pages rather than each programming one.
+constexpr uint32_t event_log_flush_seconds = 15 * 60;
+// The longest sleep between schedule updates. The RTC is the reference for the schedule,
+// so this bounds how far the timer can drift from it, and how long a change to the clock
+// takes to be seen.
+constexpr uint32_t maximum_sleep_seconds = 60 * 60;
+// The controller's location and the RTC's offset from UTC, for sunrise and sunset, until
+// a configuration is stored. The RTC is kept in local standard time.
+constexpr float default_latitude = 37.77f;
+constexpr float default_longitude = -122.42f;
+constexpr int16_t default_utc_offset_minutes = -8 * 60;
+// The RTC's INT/SQW pin, an open drain output pulled low by its alarm.
+constexpr uint rtc_alarm_gpio = 11;
+
+static uint32_t readUptimeSeconds() {
+  return to_ms_since_boot(get_absolute_time()) / 1000;
+}
+
+///
+/// \brief The configuration used until one is stored.
+/// \description On from half an hour before sunrise to half an hour after sunset.
+///
+static void setDefaultConfiguration(Core::StoredConfiguration& storedConfiguration) {
+  storedConfiguration.latitude = default_latitude;
+  storedConfiguration.longitude = default_longitude;
+  storedConfiguration.utcOffsetMinutes = default_utc_offset_minutes;
+  Core::ScheduleRule daylight;
+  daylight.startAnchor = Core::ScheduleRule::Anchor::sunrise;
+  daylight.startOffsetMinutes = -30;
+  daylight.endAnchor = Core::ScheduleRule::Anchor::sunset;
+  daylight.endOffsetMinutes = 30;
+  storedConfiguration.addRule(daylight);
+}
+
+// Kept out of the stack, which is only a couple of kilobytes.
+static Core::StoredConfiguration defaultConfiguration;
+
 int main() {
 
   //
@@ -64,22 +123,110 @@ int main() {
   Device::AfPowerRelayDevice powerDevice(Device::RelayControlGpio::gpio10);
   powerDevice.init();
   
+  // The configuration is used in place from flash. Without a valid one the default is
+  // stored, so it can be changed without reflashing the program.
+  auto loadStart = get_absolute_time();
+  Core::FlashRegion configurationRegion(configuration_offset, 
+                                        Core::ConfigurationStore::slot_count);
+  Core::ConfigurationStore configurationStore(configurationRegion);
+  auto storedConfiguration = configurationStore.load();
+  auto loadTime = absolute_time_diff_us(loadStart, get_absolute_time());
+  if (storedConfiguration == nullptr) {
+    setDefaultConfiguration(defaultConfiguration);
+    configurationStore.save(defaultConfiguration);
+    storedConfiguration = &defaultConfiguration;
+  }
+  
   Core::ControlConfiguration configuration;
-  configuration.startTime.hour = 6; 
-  configuration.startTime.minutes = 30;
-  configuration.startTime.seconds = 0;
-  configuration.endTime.hour = 20;
-  configuration.endTime.minutes = 0;
-  configuration.endTime.seconds = 0;
+  Core::SolarCalculator solarCalculator(storedConfiguration->latitude, 
+                                        storedConfiguration->longitude,
+                                        storedConfiguration->utcOffsetMinutes);
+  Core::ScheduleCalendar calendar;
+  calendar.setSolarCalculator(solarCalculator);
+  storedConfiguration->apply(configuration, calendar);
   
+#if POWER_CONTROLLER_DORMANT
+  gpio_init(rtc_alarm_gpio);
+  gpio_pull_up(rtc_alarm_gpio);
+  Core::TimeScheduler scheduler(powerDevice, timeDevice, configuration, timeDevice);
+#else
   Core::TimeScheduler scheduler(powerDevice, timeDevice, configuration);
+#endif
+  scheduler.setCalendar(calendar);
+  
+  Core::FlashRegion eventLogRegion(event_log_offset, event_log_sector_count);
+  Core::EventLog eventLog(eventLogRegion);
+  eventLog.init();
+  
+  Device::StdioSerialPort serialPort;
+  Core::CommandLink link(serialPort);
+  Controller controller = {
+    timeDevice, powerDevice, scheduler, configuration, calendar, solarCalculator, 
+    configurationStore, storedConfiguration, link, readUptimeSeconds
+  };
+  Core::CommandLink::Request request;
   
+  bool firstDecision = true;
+  auto eventLogFlushTime = get_absolute_time();
   
 loop:
-  auto time = timeDevice.readTime();
+  auto status = powerDevice.getStatus();
   scheduler.update();
+  if (firstDecision) {
+    printf("Configuration slot %d, sequence %lu, %lu corrupt slots, loaded in %lld us, "
+           "first decision %llu us from boot\n", configurationStore.getSlot(),
+           configurationStore.getSequence(), configurationStore.getCorruptSlotCount(), 
+           loadTime, to_us_since_boot(get_absolute_time()));
+    firstDecision = false;
+  }
+  if (powerDevice.getStatus() != status) {
+    Core::EventRecord record = {};
+    record.clockDatum = timeDevice.read();
+    record.type = Core::EventRecord::powerChange;
+    record.powerState = powerDevice.getStatus();
+    eventLog.append(record);
+    if (eventLog.getStagedCount() == 1) {
+      eventLogFlushTime = make_timeout_time_ms(event_log_flush_seconds * 1000);
+    }
+  }
+  if (eventLog.getStagedCount() > 0 && time_reached(eventLogFlushTime)) {
+    eventLog.flush();
+  }
   
-  sleep_ms(1000); // sleep for 1 seconds
+#if POWER_CONTROLLER_DORMANT
+  // Sleep dormant until the RTC's alarm for the next transition, unless a host has the
+  // USB port open, which dormant sleep would stop. Waking on the low level rather than 
+  // the edge means an alarm that triggered while updating wakes straight away.
+  if (!stdio_usb_connected()) {
+    // Only the RTC's alarm wakes the core, so the staged records are programmed first.
+    eventLog.flush();
+    sleep_run_from_xosc();
+    sleep_goto_dormant_until_pin(rtc_alarm_gpio, false, false);
+    sleep_power_up();
+    timeDevice.clearAlarm();
+    goto loop;
+  }
+#endif
+  // Sleep until the next transition, handling requests as they arrive. Interrupts and
+  // events, such as USB's, wake the core early, and it sleeps again for the rest of the
+  // time. The schedule is updated after each request, so it takes effect straight away.
+  {
+    auto sleepSeconds = std::min(scheduler.getSecondsToNextTransition(), maximum_sleep_seconds);
+    auto wakeTime = make_timeout_time_ms(sleepSeconds * 1000);
+    if (eventLog.getStagedCount() > 0 && absolute_time_diff_us(eventLogFlushTime, wakeTime) > 0) {
+      wakeTime = eventLogFlushTime;
+    }
+    while (!time_reached(wakeTime)) {
+      if (link.poll(request)) {
+        handleRequest(request, controller);
+        break;
+      }
+      best_effort_wfe_or_timeout(wakeTime);
+    }
+  }
+#if POWER_CONTROLLER_DORMANT
+  timeDevice.clearAlarm();
+#endif
   goto loop;
   
   return 0;
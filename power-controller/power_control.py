@@ -0,0 +1,251 @@
+#!/usr/bin/env python3
+#
+# BSD 3-Clause License
+#
+# Copyright (c) 2024, Brian Keith Smith
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+#    list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+#    this list of conditions and the following disclaimer in the documentation
+#    and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+#    contributors may be used to endorse or promote products derived from
+#    this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+# FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+# DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#
+#
+# Created by Brian Smith 10/19/2026
+#
+"""Host client for the power controller's USB command protocol.
+
+Frames are COBS encoded between zero bytes. A request is an id, a command and its
+payload, a response the id, command, a status and its payload, each followed by a
+CRC-16/CCITT-FALSE of the preceding bytes, little endian. Uses only the standard
+library, on a POSIX host.
+
+  power_control.py /dev/ttyACM0 ping --count 100
+  power_control.py /dev/ttyACM0 clock [--set]
+  power_control.py /dev/ttyACM0 telemetry
+  power_control.py /dev/ttyACM0 power on|off|schedule
+  power_control.py /dev/ttyACM0 configuration read|write FILE
+"""
+
+import argparse
+import datetime
+import os
+import select
+import struct
+import sys
+import termios
+import time
+import tty
+
+PING = 0x01
+READ_CLOCK = 0x10
+WRITE_CLOCK = 0x11
+READ_TELEMETRY = 0x20
+SET_POWER = 0x30
+READ_CONFIGURATION = 0x40
+WRITE_CONFIGURATION = 0x41
+SAVE_CONFIGURATION = 0x42
+
+STATUSES = ["ok", "unknown command", "bad length", "bad value", "failed"]
+CONFIGURATION_CHUNK_SIZE = 128
+
+
+def crc16(data, crc=0xFFFF):
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021 if crc & 0x8000 else crc << 1) & 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    encoded = bytearray([0])
+    code_index = 0
+    for byte in data:
+        if byte != 0:
+            encoded.append(byte)
+        if byte == 0 or len(encoded) - code_index == 0xFF:
+            encoded[code_index] = len(encoded) - code_index
+            code_index = len(encoded)
+            encoded.append(0)
+    encoded[code_index] = len(encoded) - code_index
+    return bytes(encoded)
+
+
+def cobs_decode(data):
+    decoded = bytearray()
+    index = 0
+    while index < len(data):
+        code = data[index]
+        if code == 0 or index + code > len(data):
+            raise ValueError("bad COBS frame")
+        decoded += data[index + 1:index + code]
+        index += code
+        if code != 0xFF and index < len(data):
+            decoded.append(0)
+    return bytes(decoded)
+
+
+class ProtocolError(Exception):
+    pass
+
+
+class Link:
+    def __init__(self, path, timeout=1.0):
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        if os.isatty(self.fd):
+            tty.setraw(self.fd)
+            termios.tcflush(self.fd, termios.TCIOFLUSH)
+        self.timeout = timeout
+        self.next_id = 0
+        self.pending = bytearray()
+
+    def close(self):
+        os.close(self.fd)
+
+    def request(self, command, payload=b""):
+        request_id = self.next_id
+        self.next_id = (self.next_id + 1) & 0xFF
+        frame = bytes([request_id, command]) + payload
+        frame += struct.pack("<H", crc16(frame))
+        os.write(self.fd, b"\0" + cobs_encode(frame) + b"\0")
+
+        deadline = time.monotonic() + self.timeout
+        while True:
+            for encoded in self._frames(deadline):
+                try:
+                    response = cobs_decode(encoded)
+                except ValueError:
+                    continue
+                if len(response) < 5 or struct.unpack("<H", response[-2:])[0] != crc16(response[:-2]):
+                    continue
+                if response[0] != request_id or response[1] != command:
+                    continue
+                status = response[2]
+                if status != 0:
+                    name = STATUSES[status] if status < len(STATUSES) else str(status)
+                    raise ProtocolError(f"command 0x{command:02x} failed: {name}")
+                return response[3:-2]
+
+    def _frames(self, deadline):
+        while b"\0" not in self.pending:
+            remaining = deadline - time.monotonic()
+            if remaining <= 0 or not select.select([self.fd], [], [], remaining)[0]:
+                raise TimeoutError("no response")
+            self.pending += os.read(self.fd, 4096)
+        *frames, self.pending = self.pending.split(b"\0")
+        return [frame for frame in frames if frame]
+
+
+def ping(link, arguments):
+    times = []
+    payload = bytes(range(arguments.size))
+    for _ in range(arguments.count):
+        start = time.perf_counter()
+        if link.request(PING, payload) != payload:
+            raise ProtocolError("ping payload changed")
+        times.append((time.perf_counter() - start) * 1000.0)
+    times.sort()
+    print(f"{len(times)} round trips of {arguments.size} bytes: min {times[0]:.3f} ms, "
+          f"median {times[len(times) // 2]:.3f} ms, max {times[-1]:.3f} ms")
+
+
+def clock(link, arguments):
+    if arguments.set:
+        now = datetime.datetime.now()
+        day_of_week = (now.weekday() + 1) % 7 + 1  # Sunday is 1.
+        link.request(WRITE_CLOCK, bytes([now.second, now.minute, now.hour, day_of_week,
+                                         now.day, now.month, now.year - 2000]))
+    second, minute, hour, _, day, month, year = link.request(READ_CLOCK)
+    print(f"20{year:02}-{month:02}-{day:02} {hour:02}:{minute:02}:{second:02}")
+
+
+def telemetry(link, arguments):
+    (uptime, second, transition, sequence, slot, on, overridden,
+     frame_errors) = struct.unpack("<IIIIbBBI", link.request(READ_TELEMETRY))
+    def clock_time(seconds):
+        return f"{seconds // 3600:02}:{seconds // 60 % 60:02}:{seconds % 60:02}"
+    print(f"uptime {uptime} s, time {clock_time(second)}, next transition "
+          f"{clock_time(transition)}, power {'on' if on else 'off'}"
+          f"{' (overridden)' if overridden else ''}, configuration slot {slot} sequence "
+          f"{sequence}, frame errors {frame_errors}")
+
+
+def power(link, arguments):
+    link.request(SET_POWER, bytes([["off", "on", "schedule"].index(arguments.state)]))
+
+
+def configuration(link, arguments):
+    if arguments.action == "read":
+        data = bytearray()
+        size = None
+        while size is None or len(data) < size:
+            response = link.request(READ_CONFIGURATION, struct.pack("<H", len(data)))
+            size = struct.unpack("<H", response[2:4])[0]
+            data += response[4:]
+        with open(arguments.file, "wb") as file:
+            file.write(data)
+        print(f"read {len(data)} bytes")
+    else:
+        with open(arguments.file, "rb") as file:
+            data = file.read()
+        for offset in range(0, len(data), CONFIGURATION_CHUNK_SIZE):
+            chunk = data[offset:offset + CONFIGURATION_CHUNK_SIZE]
+            link.request(WRITE_CONFIGURATION, struct.pack("<H", offset) + chunk)
+        sequence = struct.unpack("<I", link.request(SAVE_CONFIGURATION))[0]
+        print(f"saved {len(data)} bytes as sequence {sequence}")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("port")
+    parser.add_argument("--timeout", type=float, default=1.0)
+    commands = parser.add_subparsers(dest="command", required=True)
+    command = commands.add_parser("ping")
+    command.add_argument("--count", type=int, default=10)
+    command.add_argument("--size", type=int, default=16, choices=range(161), metavar="0..160")
+    command.set_defaults(function=ping)
+    command = commands.add_parser("clock")
+    command.add_argument("--set", action="store_true", help="set to the host's local time")
+    command.set_defaults(function=clock)
+    commands.add_parser("telemetry").set_defaults(function=telemetry)
+    command = commands.add_parser("power")
+    command.add_argument("state", choices=["on", "off", "schedule"])
+    command.set_defaults(function=power)
+    command = commands.add_parser("configuration")
+    command.add_argument("action", choices=["read", "write"])
+    command.add_argument("file")
+    command.set_defaults(function=configuration)
+    arguments = parser.parse_args()
+
+    link = Link(arguments.port, arguments.timeout)
+    try:
+        arguments.function(link, arguments)
+    except (ProtocolError, TimeoutError) as error:
+        sys.exit(f"error: {error}")
+    finally:
+        link.close()
+
+
+if __name__ == "__main__":
+    main()
@@ -38,6 +38,7 @@
 #include "pico/stdlib.h"
 
 #include "AfDS3231PrecisionRtcDevice.h"
+#include "ClockFormat.h"
 #include "SerialBus.h"
 #include "RealTimeClockDevice.h"
 
@@ -57,22 +58,22 @@ int main() {
   
   Core::ClockDatum clockReading;
   
-  clockReading.date.dayOfWeek = promptForInput("Day of week? (1 = Sunday, ..., 7 = Saturday) ");
   clockReading.date.month = promptForInput("Month? (1...12) ");
   clockReading.date.dayOfMonth = promptForInput("Day of month? (1...31) ");
   clockReading.date.year = promptForInput("Year? (0...99)");
   clockReading.time.hour = promptForInput("Hour? (0...23)");
   clockReading.time.minutes = promptForInput("Minutes? (0...59)");
   clockReading.time.seconds = promptForInput("Seconds? (0...59)");
+  clockReading.date.dayOfWeek = clockReading.date.derivedDayOfWeek();
   
-  std::printf("You entered: %s", clockReading.toString());
+  std::printf("You entered: %s", Core::formatClock<Core::asctime_format>(clockReading).c_str());
   
   Core::SerialBus serialBus;
   Device::AfDS3231PrecisionRtcDevice rtc(serialBus);
   rtc.write(clockReading);
   
   auto setClockReading = rtc.read();
-  printf("RTC set to: %s", setClockReading.toString());
+  printf("RTC set to: %s", Core::formatClock<Core::asctime_format>(setClockReading).c_str());
   
   while (1) {}
   
@@ -0,0 +1,315 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "Check.h"
+#include "FakePico.h"
+
+#include "AfDS3231PrecisionRtcDevice.h"
+#include "Clock.h"
+#include "SerialBus.h"
+
+#include <cstdint>
+
+using namespace Core;
+using namespace Device;
+
+///
+/// \brief A DS3231 as its datasheet describes its registers.
+/// \description A write sets the register pointer from its first byte, and reads and
+///   writes go on from it. Each tick counts a second and sets the flag of each alarm
+///   whose unmasked fields match, and the INT/SQW pin is low while an enabled alarm's
+///   flag is set with the interrupt control bit. The clock is kept in 24 hour time.
+///
+class Ds3231Model final : public FakePico::I2cDevice {
+public:
+  static constexpr uint8_t address = 0x68;
+  static constexpr uint8_t register_count = 0x13;
+  static constexpr uint8_t control_register = 0x0e;
+  static constexpr uint8_t status_register = 0x0f;
+  // Control bits, and status bits, the oscillator stop flag set at power on.
+  static constexpr uint8_t interrupt_control = 0x04;
+  static constexpr uint8_t oscillator_stop_flag = 0x80;
+  static constexpr uint8_t alarm_flags = 0x03;
+  
+  /// \brief The registers, as at power on.
+  uint8_t registers[register_count] = {
+    0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x1c, oscillator_stop_flag, 0x00, 0x00, 0x00
+  };
+  uint32_t transferCount = 0;
+  
+  void write(const uint8_t* source, size_t length) override {
+    ++transferCount;
+    pointer = source[0] % register_count;
+    for (size_t index = 1; index < length; ++index) {
+      if (pointer == status_register) {
+        // The flags can only be cleared.
+        auto flags = oscillator_stop_flag | alarm_flags;
+        auto value = source[index];
+        registers[pointer] = (value & ~flags) | (value & registers[pointer] & flags);
+      } else {
+        registers[pointer] = source[index];
+      }
+      pointer = (pointer + 1) % register_count;
+    }
+  }
+  
+  void read(uint8_t* destination, size_t length) override {
+    ++transferCount;
+    for (size_t index = 0; index < length; ++index) {
+      destination[index] = registers[pointer];
+      pointer = (pointer + 1) % register_count;
+    }
+  }
+  
+  void tick() {
+    ClockDatum clockDatum = {
+      {fromBcd(registers[0]), fromBcd(registers[1]), fromBcd(registers[2] & 0x3f)},
+      {registers[3], fromBcd(registers[4]), fromBcd(registers[5] & 0x1f), fromBcd(registers[6])}
+    };
+    auto next = (EpochSeconds::fromClockDatum(clockDatum) + 1).toClockDatum();
+    registers[0] = toBcd(next.time.seconds);
+    registers[1] = toBcd(next.time.minutes);
+    registers[2] = toBcd(next.time.hour);
+    if (next.date.dayOfMonth != clockDatum.date.dayOfMonth) {
+      registers[3] = registers[3] % 7 + 1;
+    }
+    registers[4] = toBcd(next.date.dayOfMonth);
+    registers[5] = toBcd(next.date.month);
+    registers[6] = toBcd(next.date.year);
+    
+    if (alarmMatches(&registers[0x07], &registers[0], 4)) {
+      registers[status_register] |= 0x01;
+    }
+    if (registers[0] == 0 && alarmMatches(&registers[0x0b], &registers[1], 3)) {
+      registers[status_register] |= 0x02;
+    }
+  }
+  
+  void tick(uint32_t seconds) {
+    for (uint32_t second = 0; second < seconds; ++second) {
+      tick();
+    }
+  }
+  
+  bool isInterruptLow() const {
+    auto control = registers[control_register];
+    return (control & interrupt_control) && (control & registers[status_register] & alarm_flags);
+  }
+  
+private:
+  uint8_t pointer = 0;
+  
+  static uint8_t toBcd(uint8_t value) { return static_cast<uint8_t>(value / 10 << 4 | value % 10); }
+  static uint8_t fromBcd(uint8_t value) { return (value >> 4) * 10 + (value & 0x0f); }
+  
+  ///
+  /// \brief Whether an alarm's unmasked fields match the clock.
+  /// \description The alarm's registers run from its first field, matching the clock's
+  ///   registers from the same field. The last is the day of the week with the day bit
+  ///   set, otherwise the date.
+  ///
+  bool alarmMatches(const uint8_t* alarm, const uint8_t* clock, int count) const {
+    for (int index = 0; index < count; ++index) {
+      if (alarm[index] & 0x80) {
+        continue;
+      }
+      bool last = index == count - 1;
+      uint8_t value = alarm[index] & 0x7f;
+      if (last && (value & 0x40)) {
+        if ((value & 0x0f) != registers[3]) {
+          return false;
+        }
+      } else if (value != (last ? registers[4] : clock[index])) {
+        return false;
+      }
+    }
+    return true;
+  }
+}; // class Ds3231Model
+
+// 2026-10-19, a Monday, day 2 from Sunday.
+constexpr Date monday = {0, 19, 10, 26};
+
+static bool isSame(ClockDatum a, ClockDatum b) {
+  return a.time == b.time && a.date == b.date && a.date.dayOfWeek == b.date.dayOfWeek;
+}
+
+static void timeWrittenAndCounted() {
+  Ds3231Model model;
+  FakePico::attach(Ds3231Model::address, &model);
+  SerialBus serialBus;
+  AfDS3231PrecisionRtcDevice device(serialBus);
+  device.init();
+  
+  // The day of the week is written from the date, whatever the datum holds.
+  device.write({{58, 59, 23}, monday});
+  CHECK(model.registers[0] == 0x58 && model.registers[1] == 0x59 && model.registers[2] == 0x23);
+  CHECK(model.registers[3] == 2);
+  CHECK(model.registers[4] == 0x19 && model.registers[5] == 0x10 && model.registers[6] == 0x26);
+  CHECK(isSame(device.read(), {{58, 59, 23}, {2, 19, 10, 26}}));
+  
+  // Through midnight into Tuesday, and a whole week back to Tuesday.
+  model.tick(2);
+  CHECK(isSame(device.read(), {{0, 0, 0}, {3, 20, 10, 26}}));
+  CHECK(device.readTime() == Time{0, 0, 0});
+  CHECK(device.readDate().dayOfWeek == 3);
+  model.tick(7 * Time::seconds_per_day);
+  CHECK(isSame(device.read(), {{0, 0, 0}, {3, 27, 10, 26}}));
+  
+  // A read of the time and date is a single transaction after setting the pointer.
+  auto transferCount = model.transferCount;
+  device.read();
+  CHECK(model.transferCount - transferCount == 2);
+  FakePico::attach(Ds3231Model::address, nullptr);
+}
+
+static void dailyAlarmArmedAndCleared() {
+  Ds3231Model model;
+  FakePico::attach(Ds3231Model::address, &model);
+  SerialBus serialBus;
+  AfDS3231PrecisionRtcDevice device(serialBus);
+  device.write({{0, 0, 7}, monday});
+  
+  // A flag left from before is cleared, so the pin is released until the alarm.
+  model.registers[Ds3231Model::status_register] |= 0x01;
+  device.armAlarm({0, 30, 7});
+  CHECK(model.registers[0x07] == 0x00 && model.registers[0x08] == 0x30);
+  CHECK(model.registers[0x09] == 0x07 && (model.registers[0x0a] & 0x80));
+  CHECK(model.registers[Ds3231Model::control_register] & Ds3231Model::interrupt_control);
+  CHECK(!model.isInterruptLow());
+  // The oscillator stop flag is left as it is.
+  CHECK(model.registers[Ds3231Model::status_register] & Ds3231Model::oscillator_stop_flag);
+  
+  model.tick(30 * 60 - 1);
+  CHECK(!model.isInterruptLow());
+  CHECK(!device.clearAlarm());
+  model.tick();
+  CHECK(model.isInterruptLow());
+  CHECK(device.clearAlarm());
+  CHECK(!model.isInterruptLow());
+  CHECK(!device.clearAlarm());
+  
+  // The same time each day, whatever the date.
+  model.tick(Time::seconds_per_day);
+  CHECK(model.isInterruptLow());
+  device.clearAlarm();
+  
+  // Disarmed, the alarm still sets its flag, but not the pin.
+  device.disarmAlarm();
+  model.tick(Time::seconds_per_day);
+  CHECK(!model.isInterruptLow());
+  CHECK(device.readAlarmFlags() == AfDS3231PrecisionRtcDevice::alarm1Flag);
+  FakePico::attach(Ds3231Model::address, nullptr);
+}
+
+///
+/// \brief Count the seconds in which an alarm's flag is set over a span of ticks.
+///
+static uint32_t countAlarms(Ds3231Model& model, AfDS3231PrecisionRtcDevice& device,
+                            uint8_t flag, uint32_t seconds) {
+  uint32_t count = 0;
+  for (uint32_t second = 0; second < seconds; ++second) {
+    model.tick();
+    if (device.readAlarmFlags() & flag) {
+      ++count;
+      device.clearAlarmFlags(flag);
+    }
+  }
+  return count;
+}
+
+static void matchModes() {
+  using Alarm1Mode = AfDS3231PrecisionRtcDevice::Alarm1Mode;
+  using Alarm2Mode = AfDS3231PrecisionRtcDevice::Alarm2Mode;
+  constexpr auto alarm1 = AfDS3231PrecisionRtcDevice::alarm1Flag;
+  constexpr auto alarm2 = AfDS3231PrecisionRtcDevice::alarm2Flag;
+  constexpr uint32_t hour = 60 * 60;
+  constexpr uint32_t week = 7 * Time::seconds_per_day;
+  
+  Ds3231Model model;
+  FakePico::attach(Ds3231Model::address, &model);
+  SerialBus serialBus;
+  AfDS3231PrecisionRtcDevice device(serialBus);
+  ClockDatum start = {{0, 0, 0}, monday};
+  // Wednesday the 21st at 12:34:56.
+  ClockDatum alarm = {{56, 34, 12}, {4, 21, 10, 26}};
+  
+  device.write(start);
+  device.setAlarm1(Alarm1Mode::everySecond, alarm);
+  CHECK(countAlarms(model, device, alarm1, 100) == 100);
+  device.setAlarm1(Alarm1Mode::seconds, alarm);
+  CHECK(countAlarms(model, device, alarm1, hour) == 60);
+  device.setAlarm1(Alarm1Mode::minutesSeconds, alarm);
+  CHECK(countAlarms(model, device, alarm1, 2 * hour) == 2);
+  device.setAlarm1(Alarm1Mode::hoursMinutesSeconds, alarm);
+  device.write(start);
+  CHECK(countAlarms(model, device, alarm1, week) == 7);
+  device.setAlarm1(Alarm1Mode::dayTime, alarm);
+  device.write(start);
+  CHECK(countAlarms(model, device, alarm1, 2 * week) == 2);
+  // The date matches once in the month, on the 21st, and never once past it.
+  device.setAlarm1(Alarm1Mode::dateTime, alarm);
+  device.write(start);
+  CHECK(countAlarms(model, device, alarm1, week) == 1);
+  CHECK(device.read().date.dayOfMonth == 26);
+  CHECK(countAlarms(model, device, alarm1, week) == 0);
+  
+  // Alarm 2 matches at the start of a minute.
+  device.write(start);
+  device.setAlarm2(Alarm2Mode::everyMinute, alarm);
+  CHECK(countAlarms(model, device, alarm2, hour) == 60);
+  device.setAlarm2(Alarm2Mode::minutes, alarm);
+  CHECK(countAlarms(model, device, alarm2, 3 * hour) == 3);
+  device.setAlarm2(Alarm2Mode::hoursMinutes, alarm);
+  device.write(start);
+  CHECK(countAlarms(model, device, alarm2, week) == 7);
+  device.setAlarm2(Alarm2Mode::dayTime, alarm);
+  device.write(start);
+  CHECK(countAlarms(model, device, alarm2, week) == 1);
+  
+  // Each alarm's interrupt is enabled and disabled alone.
+  device.enableAlarmInterrupts(alarm1 | alarm2);
+  device.disableAlarmInterrupts(alarm2);
+  CHECK((model.registers[Ds3231Model::control_register] & 0x07) == 
+        (Ds3231Model::interrupt_control | alarm1));
+  FakePico::attach(Ds3231Model::address, nullptr);
+}
+
+int main() {
+  timeWrittenAndCounted();
+  dailyAlarmArmedAndCleared();
+  matchModes();
+  return Tests::finish("AfDS3231PrecisionRtcDeviceTest");
+}
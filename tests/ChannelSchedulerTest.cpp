@@ -0,0 +1,139 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "Check.h"
+
+#include "ChannelScheduler.h"
+#include "ControlConfiguration.h"
+#include "PowerDevice.h"
+#include "RecordingPowerDevice.h"
+#include "VirtualClockDevice.h"
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+
+using namespace Core;
+
+// 2026-10-19, a Monday.
+constexpr Date monday = {2, 19, 10, 26};
+
+// Kept out of the stack, as on the Pico.
+static RecordingPowerDevice devices[ChannelScheduler::maximum_channels];
+static ControlConfiguration configurations[4];
+
+static void channelsFollowSharedConfigurations() {
+  VirtualClockDevice clockDevice;
+  static ChannelScheduler scheduler(clockDevice);
+  for (size_t index = 0; index < 4; ++index) {
+    auto hour = static_cast<uint8_t>(8 + index);
+    configurations[index].addWindow({0, 0, hour}, {0, 0, 17});
+  }
+  for (size_t channel = 0; channel < ChannelScheduler::maximum_channels; ++channel) {
+    CHECK(scheduler.addChannel(devices[channel], configurations[channel % 4]));
+  }
+  CHECK(!scheduler.addChannel(devices[0], configurations[0]));
+  CHECK(scheduler.getChannelCount() == ChannelScheduler::maximum_channels);
+  CHECK(scheduler.getConfigurationCount() == 4);
+  
+  clockDevice.write({{0, 30, 9}, monday});
+  CHECK(scheduler.update() == ChannelScheduler::maximum_channels / 2);
+  CHECK(devices[0].getStatus() == PowerDevice::on);
+  CHECK(devices[2].getStatus() == PowerDevice::off);
+  CHECK(scheduler.getSecondsToNextTransition() == 30 * 60);
+  CHECK(scheduler.update() == 0);
+  
+  // A change to a shared configuration reaches each of its channels, and only them.
+  configurations[2].addWindow({0, 0, 9}, {0, 0, 10});
+  CHECK(scheduler.update() == ChannelScheduler::maximum_channels / 4);
+  auto changes = scheduler.getChanges();
+  CHECK(changes[0].channel == 2 && changes[0].state == PowerDevice::on);
+  CHECK(devices[6].getStatus() == PowerDevice::on);
+  CHECK(devices[6].getChangeCount() == 1);
+  CHECK(devices[5].getChangeCount() == 1);
+  CHECK(devices[7].getChangeCount() == 0);
+  
+  // A configuration's power level and transition are taken with its next change.
+  configurations[1].powerLevel = 0.5f;
+  configurations[1].transitionDuration = 2000;
+  configurations[1].addWindow({0, 0, 20}, {0, 0, 21});
+  CHECK(scheduler.update() == 0);
+  CHECK(devices[1].getPowerLevel() == 0.5f && devices[1].getTransitionDuration() == 2000);
+  CHECK(devices[5].getPowerLevel() == 0.5f);
+  CHECK(devices[0].getPowerLevel() == 1.0f && devices[0].getTransitionDuration() == 0);
+}
+
+///
+/// \brief Time updates of a scheduler of a number of channels, over a day.
+/// \description Each channel has its own configuration with a window, a minute later for
+///   each channel, so updates a second apart mostly find the spans still hold, and a
+///   transition every minute searches one channel.
+///
+static void updateCost(size_t channelCount) {
+  static ControlConfiguration ownConfigurations[ChannelScheduler::maximum_channels];
+  static RecordingPowerDevice ownDevices[ChannelScheduler::maximum_channels];
+  VirtualClockDevice clockDevice;
+  // On the heap, being too large for the stack.
+  auto scheduler = std::make_unique<ChannelScheduler>(clockDevice);
+  for (size_t channel = 0; channel < channelCount; ++channel) {
+    ownConfigurations[channel].clearWindows();
+    auto minute = static_cast<uint32_t>(channel % (6 * 60));
+    ownConfigurations[channel].addWindow(Time::fromSeconds(6 * 3600 + minute * 60), 
+                                         Time::fromSeconds(18 * 3600 + minute * 60));
+    CHECK(scheduler->addChannel(ownDevices[channel], ownConfigurations[channel]));
+  }
+  
+  clockDevice.write({{0, 0, 0}, monday});
+  uint32_t changeCount = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t second = 0; second < Time::seconds_per_day; ++second) {
+    changeCount += scheduler->update();
+    clockDevice.advance(1);
+  }
+  auto now = std::chrono::steady_clock::now();
+  auto elapsed = std::chrono::duration<double, std::nano>(now - start);
+  std::printf("%lu channels: %.0f ns an update\n", static_cast<unsigned long>(channelCount), 
+              elapsed.count() / Time::seconds_per_day);
+  
+  // Each channel is on and off once.
+  CHECK(changeCount == 2 * channelCount);
+}
+
+int main() {
+  channelsFollowSharedConfigurations();
+  updateCost(8);
+  updateCost(64);
+  updateCost(ChannelScheduler::maximum_channels);
+  return Tests::finish("ChannelSchedulerTest");
+}
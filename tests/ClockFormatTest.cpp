@@ -0,0 +1,162 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "Check.h"
+
+#include "Clock.h"
+#include "ClockFormat.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string_view>
+
+using namespace Core;
+
+// The text is known when compiled.
+constexpr ClockDatum example = {{9, 5, 14}, {0, 19, 10, 26}};
+static_assert(std::string_view(formatClock<iso8601_format>(example).c_str()) == 
+              "2026-10-19T14:05:09");
+static_assert(std::string_view(formatClock<asctime_format>({{0, 0, 0}, {0, 5, 1, 0}}).c_str()) ==
+              "Wed Jan  5 00:00:00 2000\n");
+
+///
+/// \brief The C library's broken down time for a clock datum.
+///
+static std::tm toTm(ClockDatum clockDatum) {
+  std::tm tm = {};
+  tm.tm_year = 100 + clockDatum.date.year;
+  tm.tm_mon = clockDatum.date.month - 1;
+  tm.tm_mday = clockDatum.date.dayOfMonth;
+  tm.tm_hour = clockDatum.time.hour;
+  tm.tm_min = clockDatum.time.minutes;
+  tm.tm_sec = clockDatum.time.seconds;
+  tm.tm_wday = clockDatum.date.derivedDayOfWeek() - 1;
+  return tm;
+}
+
+///
+/// \brief A datum for each day of the clock's century, at a time that varies by day.
+///
+static ClockDatum datumOfDay(uint32_t day) {
+  auto seconds = (day * 7919u) % Time::seconds_per_day;
+  return {Time::fromSeconds(seconds), Date::fromDays(day)};
+}
+
+constexpr uint32_t century_days = 36525;
+
+///
+/// \brief Whether a format's text matches strftime's over every day of the century.
+///
+template <auto format>
+static bool matchesStrftime() {
+  for (uint32_t day = 0; day < century_days; ++day) {
+    auto clockDatum = datumOfDay(day);
+    auto tm = toTm(clockDatum);
+    char expected[64];
+    std::strftime(expected, sizeof(expected), format.spec, &tm);
+    char text[format.length() + 1];
+    auto length = formatClock<format>(clockDatum, text);
+    if (length != format.length() || std::strcmp(text, expected) != 0) {
+      std::printf("%s: \"%s\", strftime \"%s\"\n", format.spec, text, expected);
+      return false;
+    }
+  }
+  return true;
+}
+
+static void formatsMatchStrftime() {
+  CHECK(matchesStrftime<iso8601_format>());
+  CHECK(matchesStrftime<date_format>());
+  CHECK(matchesStrftime<hour_minute_format>());
+  CHECK(matchesStrftime<asctime_format>());
+  static constexpr ClockFormat every_field{"%y %b %e %a 100%%"};
+  CHECK(matchesStrftime<every_field>());
+  
+  // The layout of asctime too.
+  auto clockDatum = datumOfDay(9785);
+  auto tm = toTm(clockDatum);
+  CHECK(std::strcmp(formatClock<asctime_format>(clockDatum).c_str(), std::asctime(&tm)) == 0);
+}
+
+///
+/// \brief Time a formatter over every day of the century, in nanoseconds a datum.
+///
+template <typename Formatter>
+static double timeFormatting(Formatter formatter, size_t& checksum) {
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t day = 0; day < century_days; ++day) {
+    checksum += formatter(datumOfDay(day));
+  }
+  auto now = std::chrono::steady_clock::now();
+  auto elapsed = std::chrono::duration<double, std::nano>(now - start);
+  return elapsed.count() / century_days;
+}
+
+static void formattingTimed() {
+  size_t checksum = 0;
+  auto formatNs = timeFormatting([](ClockDatum clockDatum) {
+    char text[asctime_format.length() + 1];
+    return formatClock<asctime_format>(clockDatum, text) + static_cast<size_t>(text[0]);
+  }, checksum);
+  auto snprintfNs = timeFormatting([](ClockDatum clockDatum) {
+    char text[32];
+    static constexpr char day_names[][4] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+    static constexpr char month_names[][4] = {
+      "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+    };
+    auto length = std::snprintf(text, sizeof(text), "%s %s %2u %02u:%02u:%02u %u\n",
+                                day_names[clockDatum.date.derivedDayOfWeek() - 1],
+                                month_names[clockDatum.date.month - 1],
+                                clockDatum.date.dayOfMonth, clockDatum.time.hour,
+                                clockDatum.time.minutes, clockDatum.time.seconds,
+                                2000u + clockDatum.date.year);
+    return static_cast<size_t>(length) + static_cast<size_t>(text[0]);
+  }, checksum);
+  auto asctimeNs = timeFormatting([](ClockDatum clockDatum) {
+    auto tm = toTm(clockDatum);
+    auto text = std::asctime(&tm);
+    return std::strlen(text) + static_cast<size_t>(text[0]);
+  }, checksum);
+  std::printf("asctime layout: formatClock %.0f ns, snprintf %.0f ns, asctime %.0f ns\n", 
+              formatNs, snprintfNs, asctimeNs);
+  CHECK(checksum > 0);
+}
+
+int main() {
+  formatsMatchStrftime();
+  formattingTimed();
+  return Tests::finish("ClockFormatTest");
+}
@@ -0,0 +1,264 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "Check.h"
+
+#include "Cobs.h"
+#include "CommandHandler.h"
+#include "CommandLink.h"
+#include "ConfigurationStore.h"
+#include "ControlConfiguration.h"
+#include "Crc.h"
+#include "FlashRegion.h"
+#include "RecordingPowerDevice.h"
+#include "ScheduleCalendar.h"
+#include "SerialPort.h"
+#include "SolarCalculator.h"
+#include "TimeScheduler.h"
+#include "VirtualClockDevice.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+using namespace Core;
+
+// 2026-10-19, a Monday.
+constexpr Date monday = {2, 19, 10, 26};
+// Offsets into the readTelemetry response.
+constexpr size_t telemetry_power_state = 17;
+constexpr size_t telemetry_overridden = 18;
+
+///
+/// \brief A serial port with the host's side in memory.
+///
+class LoopbackSerialPort final : public SerialPort {
+public:
+  int read() override { return readIndex < input.size() ? input[readIndex++] : -1; }
+  void write(const uint8_t* source, size_t length) override {
+    output.insert(output.end(), source, source + length);
+  }
+  
+  std::vector<uint8_t> input;
+  size_t readIndex = 0;
+  std::vector<uint8_t> output;
+}; // class LoopbackSerialPort
+
+struct Response {
+  CommandLink::Status status = CommandLink::Status::failed;
+  std::vector<uint8_t> payload;
+};
+
+static uint32_t readUptimeSeconds() {
+  return 42;
+}
+
+///
+/// \brief The controller's objects, wired as the controller's main does.
+///
+struct Bench {
+  VirtualClockDevice clockDevice;
+  RecordingPowerDevice powerDevice;
+  ControlConfiguration configuration;
+  ScheduleCalendar calendar;
+  SolarCalculator solarCalculator{37.77f, -122.42f, -8 * 60};
+  FlashRegion region{0, ConfigurationStore::slot_count};
+  ConfigurationStore store{region};
+  const StoredConfiguration* storedConfiguration = nullptr;
+  TimeScheduler scheduler{powerDevice, clockDevice, configuration};
+  LoopbackSerialPort port;
+  CommandLink link{port};
+  Controller controller = {
+    clockDevice, powerDevice, scheduler, configuration, calendar, solarCalculator,
+    store, storedConfiguration, link, readUptimeSeconds
+  };
+  uint8_t nextId = 1;
+  
+  ///
+  /// \brief Store a configuration on from 08:00 to 17:00 and schedule from it at noon.
+  ///
+  Bench() {
+    region.eraseSector(0);
+    region.eraseSector(1);
+    StoredConfiguration initial;
+    initial.addRule({ScheduleRule::everyDay, {1, 1}, {12, 31}, {0, 0, 8}, {0, 0, 17}});
+    store.save(initial);
+    storedConfiguration = store.load();
+    calendar.setSolarCalculator(solarCalculator);
+    storedConfiguration->apply(configuration, calendar);
+    scheduler.setCalendar(calendar);
+    clockDevice.write({{0, 0, 12}, monday});
+    scheduler.update();
+  }
+  
+  ///
+  /// \brief Send a request over the link, handle it and update the schedule, as the
+  ///   controller's loop does, then decode the response.
+  ///
+  Response exchange(Command command, const std::vector<uint8_t>& payload = {}) {
+    std::vector<uint8_t> frame = {nextId++, static_cast<uint8_t>(command)};
+    frame.insert(frame.end(), payload.begin(), payload.end());
+    auto crc = crc16(frame.data(), frame.size());
+    frame.push_back(static_cast<uint8_t>(crc));
+    frame.push_back(static_cast<uint8_t>(crc >> 8));
+    std::vector<uint8_t> encoded(cobsEncodedSize(frame.size()));
+    encoded.resize(cobsEncode(frame.data(), frame.size(), encoded.data()));
+    port.input.push_back(0);
+    port.input.insert(port.input.end(), encoded.begin(), encoded.end());
+    port.input.push_back(0);
+    
+    Response response;
+    CommandLink::Request request;
+    if (!link.poll(request)) {
+      return response;
+    }
+    handleRequest(request, controller);
+    scheduler.update();
+    
+    // The response is the one frame between the delimiters.
+    std::vector<uint8_t> decoded(port.output.size());
+    size_t length = port.output.size() < 2 ? 0 :
+      cobsDecode(&port.output[1], port.output.size() - 2, decoded.data());
+    port.output.clear();
+    if (length < 5 || decoded[0] != frame[0] || decoded[1] != frame[1] ||
+      crc16(decoded.data(), length - 2) != (decoded[length - 2] | decoded[length - 1] << 8))
+    {
+      return response;
+    }
+    response.status = static_cast<CommandLink::Status>(decoded[2]);
+    response.payload.assign(&decoded[3], &decoded[length - 2]);
+    return response;
+  }
+  
+  ///
+  /// \brief Stage a configuration in chunks, as a host does.
+  ///
+  bool stage(const StoredConfiguration& staged) {
+    auto bytes = reinterpret_cast<const uint8_t*>(&staged);
+    for (size_t offset = 0; offset < sizeof(staged); offset += 128) {
+      size_t length = std::min<size_t>(128, sizeof(staged) - offset);
+      std::vector<uint8_t> payload = {static_cast<uint8_t>(offset), 
+                                      static_cast<uint8_t>(offset >> 8)};
+      payload.insert(payload.end(), bytes + offset, bytes + offset + length);
+      if (exchange(Command::writeConfiguration, payload).status != CommandLink::Status::ok) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+static void overrideThenTelemetry() {
+  Bench bench;
+  auto telemetry = bench.exchange(Command::readTelemetry);
+  CHECK(telemetry.status == CommandLink::Status::ok);
+  CHECK(telemetry.payload.size() == 23);
+  CHECK(telemetry.payload[telemetry_power_state] == 1);
+  CHECK(telemetry.payload[telemetry_overridden] == 0);
+  
+  // Each request is followed by an update in the same second.
+  CHECK(bench.exchange(Command::setPower, {0}).status == CommandLink::Status::ok);
+  telemetry = bench.exchange(Command::readTelemetry);
+  CHECK(telemetry.payload[telemetry_power_state] == 0);
+  CHECK(telemetry.payload[telemetry_overridden] == 1);
+  telemetry = bench.exchange(Command::readTelemetry);
+  CHECK(telemetry.payload[telemetry_power_state] == 0);
+  CHECK(telemetry.payload[telemetry_overridden] == 1);
+  
+  CHECK(bench.exchange(Command::setPower, {2}).status == CommandLink::Status::ok);
+  telemetry = bench.exchange(Command::readTelemetry);
+  CHECK(telemetry.payload[telemetry_power_state] == 1);
+  CHECK(telemetry.payload[telemetry_overridden] == 0);
+}
+
+static void outOfRangeFieldsRejected() {
+  Bench bench;
+  CHECK(bench.exchange(Command::setPower, {3}).status == CommandLink::Status::badValue);
+  CHECK(!bench.scheduler.isOverridden());
+  
+  // The 30th of February.
+  CHECK(bench.exchange(Command::writeClock, {0, 0, 12, 2, 30, 2, 26}).status == 
+        CommandLink::Status::badValue);
+  CHECK(bench.clockDevice.readDate() == monday);
+  
+  CHECK(bench.exchange(Command::ping, {7, 0, 9}).payload == std::vector<uint8_t>{7, 0, 9});
+  
+  // The longest request's payload is echoed, and a longer request dropped.
+  std::vector<uint8_t> longest(CommandLink::maximum_payload, 0xa5);
+  auto echoed = bench.exchange(Command::ping, longest);
+  CHECK(echoed.status == CommandLink::Status::ok);
+  CHECK(echoed.payload == longest);
+  longest.push_back(0xa5);
+  CHECK(bench.exchange(Command::ping, longest).status == CommandLink::Status::failed);
+  CHECK(bench.link.getFrameErrorCount() == 1);
+  CHECK(bench.exchange(static_cast<Command>(0x7f)).status == 
+        CommandLink::Status::unknownCommand);
+}
+
+static void badConfigurationNotSaved() {
+  Bench bench;
+  auto sequence = bench.store.getSequence();
+  
+  StoredConfiguration staged = *bench.storedConfiguration;
+  staged.rules[0].endTime = {0, 0, 24};
+  CHECK(bench.stage(staged));
+  CHECK(bench.exchange(Command::saveConfiguration).status == CommandLink::Status::badValue);
+  CHECK(bench.store.getSequence() == sequence);
+  CHECK(bench.powerDevice.getStatus() == PowerDevice::on);
+  
+  // Staged past the end of the configuration.
+  uint16_t end = sizeof(StoredConfiguration);
+  CHECK(bench.exchange(Command::writeConfiguration, 
+                       {static_cast<uint8_t>(end), static_cast<uint8_t>(end >> 8), 0}).status ==
+        CommandLink::Status::badLength);
+  
+  // Corrected, it is saved and scheduled from straight away, with its settings.
+  staged.rules[0].endTime = {0, 0, 11};
+  staged.powerLevel = 0.25f;
+  staged.transitionDuration = 5000;
+  CHECK(bench.stage(staged));
+  auto saved = bench.exchange(Command::saveConfiguration);
+  CHECK(saved.status == CommandLink::Status::ok);
+  CHECK(bench.store.getSequence() == sequence + 1);
+  CHECK(bench.powerDevice.getStatus() == PowerDevice::off);
+  CHECK(bench.powerDevice.getPowerLevel() == 0.25f);
+  CHECK(bench.powerDevice.getTransitionDuration() == 5000);
+}
+
+int main() {
+  overrideThenTelemetry();
+  outOfRangeFieldsRejected();
+  badConfigurationNotSaved();
+  return Tests::finish("CommandDispatchTest");
+}
@@ -0,0 +1,123 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "Check.h"
+
+#include "ConfigurationStore.h"
+#include "FlashRegion.h"
+
+#include <cmath>
+
+using namespace Core;
+
+static StoredConfiguration validConfiguration() {
+  StoredConfiguration configuration;
+  configuration.powerLevel = 0.5f;
+  configuration.latitude = 37.77f;
+  configuration.longitude = -122.42f;
+  configuration.utcOffsetMinutes = -7 * 60;
+  configuration.addRule({ScheduleRule::weekdays, {2, 29}, {10, 31}, {0, 0, 18}, {0, 0, 23}});
+  configuration.addException({{0, 29, 2, 28}, false, {0, 0, 12}, {0, 0, 13}});
+  return configuration;
+}
+
+static void configurationChecked() {
+  CHECK(validConfiguration().isValid());
+  
+  auto configuration = validConfiguration();
+  configuration.rules[0].endTime = {0, 60, 23};
+  CHECK(!configuration.isValid());
+  
+  configuration = validConfiguration();
+  configuration.rules[0].daysOfWeek = 0x80;
+  CHECK(!configuration.isValid());
+  
+  configuration = validConfiguration();
+  configuration.rules[0].lastDay = {4, 31};
+  CHECK(!configuration.isValid());
+  
+  configuration = validConfiguration();
+  configuration.rules[0].startOffsetMinutes = ScheduleRule::maximum_offset_minutes + 1;
+  CHECK(!configuration.isValid());
+  
+  configuration = validConfiguration();
+  configuration.rules[0].endAnchor = static_cast<ScheduleRule::Anchor>(3);
+  CHECK(!configuration.isValid());
+  
+  // Not a leap year.
+  configuration = validConfiguration();
+  configuration.exceptions[0].date = {0, 29, 2, 27};
+  CHECK(!configuration.isValid());
+  
+  configuration = validConfiguration();
+  configuration.exceptions[0].startTime = {0, 0, 24};
+  CHECK(!configuration.isValid());
+  
+  configuration = validConfiguration();
+  configuration.powerLevel = std::nanf("");
+  CHECK(!configuration.isValid());
+  
+  configuration = validConfiguration();
+  configuration.ruleCount = ScheduleCalendar::maximum_rules + 1;
+  CHECK(!configuration.isValid());
+}
+
+static void invalidConfigurationNotSaved() {
+  FlashRegion region(0, 2);
+  region.eraseSector(0);
+  region.eraseSector(1);
+  ConfigurationStore store(region);
+  CHECK(store.load() == nullptr);
+  
+  auto configuration = validConfiguration();
+  CHECK(store.save(configuration));
+  auto sequence = store.getSequence();
+  
+  configuration.exceptions[0].endTime = {0, 0, 255};
+  CHECK(!store.save(configuration));
+  CHECK(store.getSequence() == sequence);
+  
+  // The valid configuration is still the one loaded at boot.
+  ConfigurationStore bootStore(region);
+  auto loaded = bootStore.load();
+  CHECK(loaded != nullptr && loaded->isValid());
+  CHECK(bootStore.getSequence() == sequence);
+  CHECK(bootStore.getCorruptSlotCount() == 0);
+}
+
+int main() {
+  configurationChecked();
+  invalidConfigurationNotSaved();
+  return Tests::finish("ConfigurationStoreTest");
+}
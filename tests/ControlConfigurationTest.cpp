@@ -0,0 +1,203 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "Check.h"
+
+#include "Clock.h"
+#include "ControlConfiguration.h"
+
+#include <chrono>
+#include <cstdio>
+
+using namespace Core;
+
+constexpr uint32_t seconds_per_day = Time::seconds_per_day;
+
+///
+/// \brief Whether a second is in a window from start to end, both included, taken modulo
+///   a day so an end before the start wraps past midnight.
+///
+static bool inWindow(uint32_t second, uint32_t start, uint32_t end) {
+  return (second + seconds_per_day - start) % seconds_per_day <=
+      (end + seconds_per_day - start) % seconds_per_day;
+}
+
+///
+/// \brief Checks every second of the day against inWindow, and that each span found holds
+///   the state throughout and ends at a transition or the end of the day.
+///
+static void checkEverySecond(Time startTime, Time endTime) {
+  ControlConfiguration configuration;
+  CHECK(configuration.addWindow(startTime, endTime));
+  auto start = startTime.inSeconds();
+  auto end = endTime.inSeconds();
+  size_t mismatches = 0;
+  for (uint32_t second = 0; second < seconds_per_day; ++second) {
+    auto span = configuration.find(second);
+    bool on = inWindow(second, start, end);
+    bool holds = span.on == on && span.start <= second && second < span.end &&
+        inWindow(span.start, start, end) == on && inWindow(span.end - 1, start, end) == on &&
+        (span.start == 0 || inWindow(span.start - 1, start, end) != on) &&
+        (span.end == seconds_per_day || inWindow(span.end, start, end) != on);
+    if (!holds) {
+      ++mismatches;
+    }
+  }
+  CHECK(mismatches == 0);
+}
+
+static void wrappedWindowSplit() {
+  ControlConfiguration configuration;
+  CHECK(configuration.addWindow({0, 0, 22}, {0, 0, 6}));
+  CHECK(configuration.getWindowCount() == 2);
+  CHECK(configuration.find(Time{0, 0, 23}).on);
+  CHECK(configuration.find(Time{0, 0, 5}).on);
+  CHECK(!configuration.find(Time{0, 0, 12}).on);
+  
+  // Ending just before the start is the whole day.
+  ControlConfiguration wholeDay;
+  CHECK(wholeDay.addWindow({0, 0, 6}, {59, 59, 5}));
+  CHECK(wholeDay.getWindowCount() == 1);
+}
+
+static void wrappedWindowAddedWhole() {
+  // Fill all but one window with windows apart, from 01:00.
+  ControlConfiguration configuration;
+  for (size_t index = 0; index + 1 < ControlConfiguration::maximum_windows; ++index) {
+    auto minute = static_cast<uint8_t>(index);
+    CHECK(configuration.addWindow({0, minute, 1}, {30, minute, 1}));
+  }
+  auto revision = configuration.getRevision();
+  
+  // Only one of the two pieces fits, so neither is added.
+  CHECK(!configuration.addWindow({0, 0, 22}, {0, 30, 0}));
+  CHECK(configuration.getWindowCount() == ControlConfiguration::maximum_windows - 1);
+  CHECK(configuration.getRevision() == revision);
+  CHECK(!configuration.find(Time{0, 0, 23}).on);
+  
+  // A piece that merges takes no window of its own, so this fits.
+  CHECK(configuration.addWindow({0, 0, 22}, {0, 0, 1}));
+  CHECK(configuration.getWindowCount() == ControlConfiguration::maximum_windows);
+  CHECK(configuration.find(Time{0, 0, 23}).on);
+  CHECK(configuration.find(Time{0, 30, 0}).on);
+}
+
+static void everySecond() {
+  checkEverySecond({15, 30, 8}, {0, 45, 17});
+  checkEverySecond({0, 0, 22}, {0, 0, 6});
+  checkEverySecond({0, 0, 0}, {59, 59, 23});
+  checkEverySecond({59, 59, 23}, {0, 0, 0});
+}
+
+///
+/// \brief The span at a second by a linear scan of the windows, to compare find against.
+///
+static ControlConfiguration::Span scan(const ControlConfiguration& configuration,
+                                       uint32_t second) {
+  uint32_t start = 0;
+  for (size_t index = 0; index < configuration.getWindowCount(); ++index) {
+    auto& window = configuration.getWindow(index);
+    if (second < window.start) {
+      return {false, start, window.start};
+    }
+    if (second <= window.end) {
+      return {true, window.start, window.end + 1};
+    }
+    start = window.end + 1;
+  }
+  return {false, start, seconds_per_day};
+}
+
+///
+/// \brief Time a lookup at every second of the day, some passes over.
+/// \return The nanoseconds a lookup, and the sum of the span ends in sum.
+///
+template <typename Lookup>
+static double timeLookups(Lookup lookup, uint64_t& sum) {
+  constexpr uint32_t passes = 10;
+  sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t pass = 0; pass < passes; ++pass) {
+    for (uint32_t second = 0; second < seconds_per_day; ++second) {
+      sum += lookup(second).end;
+    }
+  }
+  auto now = std::chrono::steady_clock::now();
+  auto elapsed = std::chrono::duration<double, std::nano>(now - start);
+  return elapsed.count() / (passes * seconds_per_day);
+}
+
+///
+/// \brief Compare find with a linear scan at 1, 16 and the cap of 64 windows.
+/// \description The cap keeps a configuration to half a kilobyte, so 256 windows, as
+///   for a benchmark at larger counts, cannot be added.
+///
+static void lookupAgainstLinearScan() {
+  constexpr auto maximum_windows = static_cast<uint32_t>(ControlConfiguration::maximum_windows);
+  for (uint32_t windowCount : {1u, 16u, maximum_windows}) {
+    // Windows spread over the day, each on for half its share.
+    ControlConfiguration configuration;
+    uint32_t share = seconds_per_day / windowCount;
+    for (uint32_t index = 0; index < windowCount; ++index) {
+      configuration.addWindow(Time::fromSeconds(index * share), 
+                              Time::fromSeconds(index * share + share / 2));
+    }
+    CHECK(configuration.getWindowCount() == windowCount);
+    
+    uint64_t findSum = 0;
+    uint64_t scanSum = 0;
+    auto findNs = timeLookups([&](uint32_t second) { return configuration.find(second); }, 
+                              findSum);
+    auto scanNs = timeLookups([&](uint32_t second) { return scan(configuration, second); }, 
+                              scanSum);
+    CHECK(findSum == scanSum);
+    std::printf("%lu windows: find %.1f ns, linear scan %.1f ns a lookup\n", 
+                static_cast<unsigned long>(windowCount), findNs, scanNs);
+  }
+  
+  // The cap is the most that can be added.
+  ControlConfiguration full;
+  for (uint32_t index = 0; index <= ControlConfiguration::maximum_windows; ++index) {
+    full.addWindow(Time::fromSeconds(index * 2), Time::fromSeconds(index * 2));
+  }
+  CHECK(full.getWindowCount() == ControlConfiguration::maximum_windows);
+}
+
+int main() {
+  wrappedWindowSplit();
+  wrappedWindowAddedWhole();
+  everySecond();
+  lookupAgainstLinearScan();
+  return Tests::finish("ControlConfigurationTest");
+}
@@ -0,0 +1,68 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "Check.h"
+
+#include "DaylightController.h"
+#include "PowerDevice.h"
+#include "RecordingPowerDevice.h"
+
+using namespace Core;
+
+static void stallNotIntegrated() {
+  RecordingPowerDevice lamp;
+  DaylightController controller(lamp);
+  controller.setState(PowerDevice::on);
+  
+  // Daylight 100 lux short of the target switches the lamp on.
+  controller.update(400.0f, 1.0f);
+  CHECK(lamp.getStatus() == PowerDevice::on);
+  CHECK(controller.getOutput() == 0.0f);
+  
+  // After a 30 second stall the lamp ramps for the longest update, 2 seconds at 0.05 a
+  // second, rather than straight to its demand of 0.3.
+  controller.update(400.0f, 30.0f);
+  CHECK(controller.getOutput() < 0.11f);
+  
+  // The integral was not wound up by the stall, so the lamp settles at the level it needs.
+  for (int update = 0; update < 600; ++update) {
+    controller.update(400.0f + 500.0f * controller.getOutput(), 1.0f);
+  }
+  CHECK(controller.getOutput() > 0.19f && controller.getOutput() < 0.21f);
+}
+
+int main() {
+  stallNotIntegrated();
+  return Tests::finish("DaylightControllerTest");
+}
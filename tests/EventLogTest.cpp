@@ -0,0 +1,222 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "Check.h"
+#include "FakeFlashRegion.h"
+
+#include "EventLog.h"
+#include "FlashRegion.h"
+
+#include <vector>
+
+using namespace Core;
+
+// Few sectors, so the log wraps quickly.
+constexpr uint32_t sector_count = 4;
+constexpr uint32_t records_per_sector = EventLog::slots_per_sector - 1;
+constexpr uint32_t records_per_pass = sector_count * records_per_sector;
+
+///
+/// \brief A reading numbered by its lux, so the records read back can be checked in order.
+///
+static EventRecord reading(uint32_t number) {
+  EventRecord record = {};
+  record.clockDatum = {{0, 0, 12}, {0, 19, 10, 26}};
+  record.type = EventRecord::sensorReading;
+  record.lux = number;
+  return record;
+}
+
+static std::vector<uint32_t> readBack(const EventLog& log) {
+  std::vector<uint32_t> numbers;
+  log.forEach([&](const EventRecord& record) { numbers.push_back(record.lux); });
+  return numbers;
+}
+
+///
+/// \brief Whether the numbers run from first to last, in order.
+///
+static bool isRun(const std::vector<uint32_t>& numbers, uint32_t first, uint32_t last) {
+  if (numbers.size() != last - first + 1) {
+    return false;
+  }
+  for (uint32_t index = 0; index < numbers.size(); ++index) {
+    if (numbers[index] != first + index) {
+      return false;
+    }
+  }
+  return true;
+}
+
+///
+/// \brief The log as found after a restart.
+///
+static std::vector<uint32_t> readAfterRestart(FlashRegion& region) {
+  FakeFlash::restorePower();
+  EventLog log(region);
+  log.init();
+  return readBack(log);
+}
+
+static void programmedInPages() {
+  FakeFlash::eraseAll();
+  FlashRegion region(0, sector_count);
+  EventLog log(region);
+  log.init();
+  
+  // The first page holds the sector's header and fifteen records.
+  for (uint32_t number = 1; number < EventLog::slots_per_page; ++number) {
+    log.append(reading(number));
+  }
+  CHECK(FakeFlash::getProgramCount() == 1);
+  for (uint32_t number = EventLog::slots_per_page; number <= 20; ++number) {
+    log.append(reading(number));
+  }
+  CHECK(FakeFlash::getProgramCount() == 1);
+  CHECK(isRun(readBack(log), 1, 20));
+  CHECK(isRun(readAfterRestart(region), 1, 15));
+  
+  log.flush();
+  CHECK(FakeFlash::getProgramCount() == 2);
+  CHECK(isRun(readAfterRestart(region), 1, 20));
+}
+
+static void tornMidPage() {
+  FakeFlash::eraseAll();
+  FlashRegion region(0, sector_count);
+  {
+    EventLog log(region);
+    log.init();
+    for (uint32_t number = 1; number <= 20; ++number) {
+      log.append(reading(number));
+    }
+    log.flush();
+    
+    // Records 21 to 23 are programmed and 24 is torn, in the second page from slot 21.
+    for (uint32_t number = 21; number <= 30; ++number) {
+      log.append(reading(number));
+    }
+    uint32_t pageOffset = (21 % EventLog::slots_per_page) * EventLog::record_size;
+    FakeFlash::cutPowerAfter(pageOffset + 3 * EventLog::record_size + 7);
+    log.flush();
+    CHECK(!FakeFlash::isPowered());
+  }
+  
+  CHECK(isRun(readAfterRestart(region), 1, 23));
+  
+  // Appending resumes after the torn record.
+  EventLog log(region);
+  log.init();
+  for (uint32_t number = 24; number <= 40; ++number) {
+    log.append(reading(number));
+  }
+  log.flush();
+  CHECK(isRun(readAfterRestart(region), 1, 40));
+}
+
+///
+/// \brief Fill every sector, then cut the power at a byte of starting the oldest again.
+/// \description The record after a full pass erases the first sector, and programs its
+///   header with the record.
+///
+static void tornAtSectorWrap(uint32_t byteCount, uint32_t firstKept) {
+  FakeFlash::eraseAll();
+  FlashRegion region(0, sector_count);
+  {
+    EventLog log(region);
+    log.init();
+    for (uint32_t number = 1; number <= records_per_pass; ++number) {
+      log.append(reading(number));
+    }
+    log.append(reading(records_per_pass + 1));
+    FakeFlash::cutPowerAfter(byteCount);
+    log.flush();
+    CHECK(!FakeFlash::isPowered());
+  }
+  
+  // The torn sector's records are lost, and the rest kept.
+  CHECK(isRun(readAfterRestart(region), firstKept, records_per_pass));
+  
+  // Appending resumes in the torn sector.
+  EventLog log(region);
+  log.init();
+  for (uint32_t number = records_per_pass + 1; number <= records_per_pass + 20; ++number) {
+    log.append(reading(number));
+  }
+  log.flush();
+  CHECK(isRun(readAfterRestart(region), records_per_sector + 1, records_per_pass + 20));
+}
+
+static void tornAcrossSectorWrap() {
+  uint32_t header = EventLog::record_size;
+  // In the erase, so the header is gone and part of the oldest records with it.
+  tornAtSectorWrap(FlashRegion::sector_size / 2, records_per_sector + 1);
+  // In the header, programmed after the erase.
+  tornAtSectorWrap(FlashRegion::sector_size + header / 2, records_per_sector + 1);
+  // In the record after the header.
+  tornAtSectorWrap(FlashRegion::sector_size + header + 5, records_per_sector + 1);
+}
+
+static void erasesLevelled() {
+  FakeFlash::eraseAll();
+  FlashRegion region(0, sector_count);
+  EventLog log(region);
+  log.init();
+  
+  constexpr uint32_t passes = 10;
+  for (uint32_t number = 1; number <= passes * records_per_pass; ++number) {
+    log.append(reading(number));
+  }
+  log.flush();
+  CHECK(isRun(readBack(log), (passes - 1) * records_per_pass + 1, passes * records_per_pass));
+  
+  // Each sector is erased once a pass, for the records it holds, as the header's
+  // endurance estimate takes.
+  CHECK(records_per_sector == 255);
+  for (uint32_t sector = 0; sector < sector_count; ++sector) {
+    CHECK(FakeFlash::getEraseCount(sector) == passes);
+  }
+  CHECK(FakeFlash::getEraseCount(sector_count) == 0);
+  
+  // A page is programmed for each sixteen slots, the header's included.
+  CHECK(FakeFlash::getProgramCount() == passes * sector_count * FlashRegion::pages_per_sector);
+}
+
+int main() {
+  programmedInPages();
+  tornMidPage();
+  tornAcrossSectorWrap();
+  erasesLevelled();
+  return Tests::finish("EventLogTest");
+}
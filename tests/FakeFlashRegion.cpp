@@ -0,0 +1,122 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+// FlashRegion over a buffer in RAM, for the host tests. Programming only clears bits, as
+// it does in flash.
+
+#include "FakeFlashRegion.h"
+#include "FlashRegion.h"
+
+#include <cstring>
+
+using namespace Core;
+
+static constexpr uint32_t fake_flash_sector_count = 16;
+static constexpr uint32_t fake_flash_size = fake_flash_sector_count * FlashRegion::sector_size;
+static uint8_t fakeFlash[fake_flash_size];
+static uint32_t eraseCounts[fake_flash_sector_count];
+static uint32_t programCount = 0;
+static bool powered = true;
+static bool powerCutPending = false;
+static uint32_t bytesUntilPowerCut = 0;
+
+///
+/// \brief Take the power for one byte of an erase or program, false once it is cut.
+///
+static bool takeByte() {
+  if (powerCutPending) {
+    if (bytesUntilPowerCut == 0) {
+      powered = false;
+      powerCutPending = false;
+    } else {
+      --bytesUntilPowerCut;
+    }
+  }
+  return powered;
+}
+
+void FakeFlash::eraseAll() {
+  std::memset(fakeFlash, 0xff, sizeof(fakeFlash));
+  std::memset(eraseCounts, 0, sizeof(eraseCounts));
+  programCount = 0;
+  restorePower();
+}
+
+void FakeFlash::cutPowerAfter(uint32_t byteCount) {
+  powerCutPending = true;
+  bytesUntilPowerCut = byteCount;
+}
+
+void FakeFlash::restorePower() {
+  powered = true;
+  powerCutPending = false;
+}
+
+bool FakeFlash::isPowered() {
+  return powered;
+}
+
+uint32_t FakeFlash::getEraseCount(uint32_t sectorIndex) {
+  return eraseCounts[sectorIndex];
+}
+
+uint32_t FakeFlash::getProgramCount() {
+  return programCount;
+}
+
+const uint8_t* FlashRegion::sector(uint32_t index) const {
+  return &fakeFlash[offset + index * sector_size];
+}
+
+void FlashRegion::eraseSector(uint32_t index) {
+  if (!powered) {
+    return;
+  }
+  ++eraseCounts[offset / sector_size + index];
+  auto sector = &fakeFlash[offset + index * sector_size];
+  for (uint32_t byte = 0; byte < sector_size && takeByte(); ++byte) {
+    sector[byte] = 0xff;
+  }
+}
+
+void FlashRegion::programPage(uint32_t sectorIndex, uint32_t pageIndex, const uint8_t* data) {
+  if (!powered) {
+    return;
+  }
+  ++programCount;
+  auto page = &fakeFlash[offset + sectorIndex * sector_size + pageIndex * page_size];
+  for (uint32_t index = 0; index < page_size && takeByte(); ++index) {
+    page[index] &= data[index];
+  }
+}
@@ -0,0 +1,65 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+// Control of the FlashRegion stand-in in FakeFlashRegion.cpp, a buffer in RAM. The power
+// can be cut part way through an erase or program, which then stops at that byte as a
+// power loss would, and erases are counted for the endurance of each sector.
+
+#pragma once
+
+#include <cstdint>
+
+namespace FakeFlash {
+
+///
+/// \brief Erase the whole buffer and clear the counts, for a fresh start.
+///
+void eraseAll();
+
+///
+/// \brief Cut the power once this many more bytes are erased or programmed.
+/// \description Erases and programs go a byte at a time from the start of the sector or
+///   page. Once the power is cut they do nothing until it is restored.
+///
+void cutPowerAfter(uint32_t byteCount);
+void restorePower();
+bool isPowered();
+
+///
+/// \brief The erases of a sector, counting from the start of the buffer.
+///
+uint32_t getEraseCount(uint32_t sectorIndex);
+uint32_t getProgramCount();
+
+}; // namespace FakeFlash
@@ -0,0 +1,218 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "FakePico.h"
+
+#include "hardware/gpio.h"
+#include "hardware/i2c.h"
+#include "hardware/pwm.h"
+#include "pico/time.h"
+
+#include <algorithm>
+
+static uint64_t currentUs = 0;
+
+constexpr size_t timer_capacity = 16;
+static repeating_timer_t* timers[timer_capacity];
+static size_t timerCount = 0;
+static size_t timerSlots = timer_capacity;
+
+static FakePico::I2cDevice* i2cDevices[128];
+
+constexpr uint pwm_slice_count = 8;
+static uint16_t pwmWraps[pwm_slice_count];
+static std::vector<FakePico::PwmLevel> pwmTrace;
+
+void FakePico::advanceUs(uint64_t us) {
+  uint64_t target = currentUs + us;
+  for (;;) {
+    auto due = std::min_element(&timers[0], &timers[timerCount], 
+      [](const repeating_timer_t* a, const repeating_timer_t* b) {
+        return a->next_time < b->next_time;
+      });
+    if (due == &timers[timerCount] || (*due)->next_time > target) {
+      break;
+    }
+    auto timer = *due;
+    currentUs = std::max(currentUs, timer->next_time);
+    timer->next_time += static_cast<uint64_t>(timer->delay_us < 0 ? -timer->delay_us : timer->delay_us);
+    if (!timer->callback(timer)) {
+      cancel_repeating_timer(timer);
+    }
+  }
+  currentUs = target;
+}
+
+uint64_t FakePico::nowUs() {
+  return currentUs;
+}
+
+void FakePico::setTimerSlots(size_t slots) {
+  timerSlots = std::min(slots, timer_capacity);
+}
+
+size_t FakePico::getActiveTimerCount() {
+  return timerCount;
+}
+
+void FakePico::attach(uint8_t address, I2cDevice* device) {
+  i2cDevices[address & 0x7f] = device;
+}
+
+const std::vector<FakePico::PwmLevel>& FakePico::getPwmTrace() {
+  return pwmTrace;
+}
+
+void FakePico::clearPwmTrace() {
+  pwmTrace.clear();
+}
+
+uint16_t FakePico::getPwmWrap(unsigned int gpio) {
+  return pwmWraps[pwm_gpio_to_slice_num(gpio)];
+}
+
+//
+// pico/time.h
+//
+
+absolute_time_t get_absolute_time() { return currentUs; }
+uint64_t to_us_since_boot(absolute_time_t time) { return time; }
+uint32_t to_ms_since_boot(absolute_time_t time) { return static_cast<uint32_t>(time / 1000); }
+absolute_time_t delayed_by_us(absolute_time_t time, uint64_t us) { return time + us; }
+absolute_time_t delayed_by_ms(absolute_time_t time, uint32_t ms) { return time + ms * 1000ull; }
+absolute_time_t make_timeout_time_us(uint64_t us) { return currentUs + us; }
+absolute_time_t make_timeout_time_ms(uint32_t ms) { return currentUs + ms * 1000ull; }
+
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to) {
+  return static_cast<int64_t>(to - from);
+}
+
+bool time_reached(absolute_time_t time) { return currentUs >= time; }
+
+void sleep_until(absolute_time_t time) {
+  if (time > currentUs) {
+    FakePico::advanceUs(time - currentUs);
+  }
+}
+
+void sleep_us(uint64_t us) { FakePico::advanceUs(us); }
+void sleep_ms(uint32_t ms) { FakePico::advanceMs(ms); }
+
+bool best_effort_wfe_or_timeout(absolute_time_t time) {
+  sleep_until(time);
+  return true;
+}
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, 
+                            void* user_data, repeating_timer_t* timer) 
+{
+  if (timerCount == timerSlots || delay_us == 0) {
+    return false;
+  }
+  timer->delay_us = delay_us;
+  timer->next_time = currentUs + static_cast<uint64_t>(delay_us < 0 ? -delay_us : delay_us);
+  timer->callback = callback;
+  timer->user_data = user_data;
+  timers[timerCount++] = timer;
+  return true;
+}
+
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback,
+                            void* user_data, repeating_timer_t* timer) 
+{
+  return add_repeating_timer_us(static_cast<int64_t>(delay_ms) * 1000, callback, user_data, timer);
+}
+
+bool cancel_repeating_timer(repeating_timer_t* timer) {
+  auto found = std::find(&timers[0], &timers[timerCount], timer);
+  if (found == &timers[timerCount]) {
+    return false;
+  }
+  *found = timers[--timerCount];
+  return true;
+}
+
+//
+// hardware/i2c.h
+//
+
+i2c_inst_t* i2c_default = nullptr;
+
+unsigned int i2c_init(i2c_inst_t*, unsigned int baudrate) { return baudrate; }
+
+int i2c_write_blocking(i2c_inst_t*, uint8_t address, const uint8_t* source, size_t length, bool) {
+  auto device = i2cDevices[address & 0x7f];
+  if (device == nullptr) {
+    return -1;
+  }
+  device->write(source, length);
+  return static_cast<int>(length);
+}
+
+int i2c_read_blocking(i2c_inst_t*, uint8_t address, uint8_t* destination, size_t length, bool) {
+  auto device = i2cDevices[address & 0x7f];
+  if (device == nullptr) {
+    return -1;
+  }
+  device->read(destination, length);
+  return static_cast<int>(length);
+}
+
+//
+// hardware/gpio.h
+//
+
+void gpio_init(uint) {}
+void gpio_set_function(uint, gpio_function) {}
+void gpio_pull_up(uint) {}
+
+//
+// hardware/pwm.h
+//
+
+uint pwm_gpio_to_slice_num(uint gpio) { return (gpio >> 1) % pwm_slice_count; }
+pwm_config pwm_get_default_config() { return {0, 1 << 4, 0xffff}; }
+void pwm_config_set_wrap(pwm_config* config, uint16_t wrap) { config->top = wrap; }
+
+void pwm_config_set_clkdiv(pwm_config* config, float divider) {
+  config->div = static_cast<uint32_t>(divider * 16.0f);
+}
+
+void pwm_init(uint slice, pwm_config* config, bool) {
+  pwmWraps[slice % pwm_slice_count] = static_cast<uint16_t>(config->top);
+}
+
+void pwm_set_gpio_level(uint gpio, uint16_t level) {
+  pwmTrace.push_back({currentUs, gpio, level});
+}
@@ -0,0 +1,98 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+// Control of the host stand-ins for the Pico SDK in tests/pico. Time only moves when a
+// test advances it or the code under test sleeps, and repeating timers fire as it passes.
+// I2C transfers go to the devices attached at their addresses, and the levels set on PWM
+// outputs are traced.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace FakePico {
+
+///
+/// \brief Move the clock forward, firing the repeating timers due on the way.
+///
+void advanceUs(uint64_t us);
+inline void advanceMs(uint32_t ms) { advanceUs(static_cast<uint64_t>(ms) * 1000); }
+uint64_t nowUs();
+
+///
+/// \brief Limit the repeating timers that can be added, as the SDK's alarm pool does.
+///
+void setTimerSlots(size_t slots);
+size_t getActiveTimerCount();
+
+///
+/// \brief A device on the I2C bus.
+///
+class I2cDevice {
+public:
+  I2cDevice() = default;
+  I2cDevice(const I2cDevice&) = delete;
+  ~I2cDevice() = default;
+  
+  virtual void write(const uint8_t* source, size_t length) = 0;
+  virtual void read(uint8_t* destination, size_t length) = 0;
+}; // class I2cDevice
+
+///
+/// \brief Attach a device at an address, or detach it with null, so transfers fail.
+///
+void attach(uint8_t address, I2cDevice* device);
+
+///
+/// \brief A level set on a PWM output, and when.
+///
+struct PwmLevel {
+  uint64_t timeUs;
+  unsigned int gpio;
+  uint16_t level;
+};
+
+///
+/// \brief The levels set on PWM outputs since the trace was last cleared.
+///
+const std::vector<PwmLevel>& getPwmTrace();
+void clearPwmTrace();
+///
+/// \brief The top of the counter a PWM output's slice was started with, 0 until then.
+///
+uint16_t getPwmWrap(unsigned int gpio);
+
+}; // namespace FakePico
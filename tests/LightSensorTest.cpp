@@ -0,0 +1,179 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "Check.h"
+#include "FakePico.h"
+
+#include "AlsConfigRegister.h"
+#include "CalibrationProfile.h"
+#include "LightSensor.h"
+#include "Sampler.h"
+#include "StreamingStatistics.h"
+
+#include <cmath>
+#include <cstdint>
+
+using namespace LightMeter;
+
+///
+/// \brief A VEML7700 lit by a scene, counting as its datasheet's resolutions give.
+///
+class Veml7700Model final : public FakePico::I2cDevice {
+public:
+  static constexpr uint8_t address = 0x10;
+  
+  /// \brief The scene's lux, scaled by the lux scale.
+  uint32_t sceneLux = 0;
+  
+  void write(const uint8_t* source, size_t length) override {
+    command = source[0];
+    if (length == 3 && command < register_count) {
+      registers[command] = source[1] | static_cast<uint16_t>(source[2]) << 8;
+    }
+  }
+  
+  void read(uint8_t* destination, size_t length) override {
+    uint16_t value = command < register_count ? registers[command] : 0;
+    if (command == ambient_light_command || command == white_channel_command) {
+      AlsConfigRegister config(registers[0]);
+      uint32_t counts = sceneLux / resolutions[config.getIntegrationTime()][config.getGain()];
+      value = static_cast<uint16_t>(std::min<uint32_t>(counts, UINT16_MAX));
+    }
+    destination[0] = static_cast<uint8_t>(value);
+    if (length > 1) {
+      destination[1] = static_cast<uint8_t>(value >> 8);
+    }
+  }
+  
+private:
+  static constexpr uint8_t register_count = 7;
+  static constexpr uint8_t ambient_light_command = 0x04;
+  static constexpr uint8_t white_channel_command = 0x05;
+  // Lux per count scaled by the lux scale, by integration time then gain.
+  static constexpr uint32_t resolutions[6][4] = {
+    {21504, 10752, 2688, 1344},
+    {10752,  5376, 1344,  672},
+    { 5376,  2688,  672,  336},
+    { 2688,  1344,  336,  168},
+    { 1344,   672,  168,   84}, 
+    {  672,   336,   84,   42}
+  };
+  
+  uint8_t command = 0;
+  uint16_t registers[register_count] = {};
+}; // class Veml7700Model
+
+///
+/// \brief The datasheet's non-linearity correction of a lux.
+///
+static double polynomial(double lux) {
+  return ((((6.0135e-13 * lux) - 9.3924e-9) * lux + 8.1488e-5) * lux + 1.0023) * lux;
+}
+
+static uint32_t read(LightSensor& sensor) {
+  sensor.start();
+  while (!sensor.ready()) {
+    FakePico::advanceMs(1);
+    sensor.poll();
+  }
+  return sensor.getScaledAmbientLightLux();
+}
+
+static void brightestAtLargestGain() {
+  Veml7700Model model;
+  FakePico::attach(Veml7700Model::address, &model);
+  LightSensor sensor;
+  sensor.init();
+  
+  // At the count limit at 1/8 gain and 25 ms.
+  model.sceneLux = 10000u * 21504u;
+  CHECK(read(sensor) > 0);
+  CHECK(sensor.getGainWhenRead() == AlsConfigRegister::low);
+  CHECK(sensor.getIntegrationTimeWhenRead() == AlsConfigRegister::ms_25);
+  double expected = polynomial(21504.0);
+  CHECK(std::fabs(sensor.getAmbientLightLux() - expected) < expected * 1.0e-3);
+  
+  // The largest gain accepted for 1/8 gain, about 3x, and the next refused.
+  CalibrationProfile profile;
+  profile.gains[AlsConfigRegister::low] = static_cast<int32_t>(UINT32_MAX / 21504u);
+  CHECK(sensor.setCalibration(profile));
+  double gain = static_cast<double>(profile.gains[AlsConfigRegister::low]) 
+    / CalibrationProfile::unity_gain;
+  read(sensor);
+  CHECK(std::fabs(sensor.getAmbientLightLux() - gain * expected) < gain * expected * 1.0e-3);
+  
+  ++profile.gains[AlsConfigRegister::low];
+  CHECK(!sensor.setCalibration(profile));
+  FakePico::attach(Veml7700Model::address, nullptr);
+}
+
+static void samplerHoldsIntegrationTime() {
+  Veml7700Model model;
+  FakePico::attach(Veml7700Model::address, &model);
+  LightSensor sensor;
+  sensor.init();
+  
+  // Dim enough that, left to autorange, the sensor integrates for 800 ms.
+  model.sceneLux = 10000u;
+  read(sensor);
+  CHECK(sensor.getIntegrationTimeWhenRead() == AlsConfigRegister::ms_800);
+  
+  Sampler sampler(sensor);
+  sampler.start();
+  while (sampler.getSamples().size() < 8) {
+    FakePico::advanceMs(1);
+    if (sampler.poll()) {
+      CHECK(sensor.getIntegrationTimeWhenRead() == Sampler::integration_time);
+    }
+  }
+  FakePico::attach(Veml7700Model::address, nullptr);
+}
+
+static void medianOfEvenCount() {
+  StreamingStatistics statistics;
+  statistics.add(1.0f);
+  statistics.add(4.0f);
+  CHECK(statistics.getMedian() == 2.5f);
+  statistics.add(2.0f);
+  CHECK(statistics.getMedian() == 2.0f);
+  statistics.add(8.0f);
+  CHECK(statistics.getMedian() == 3.0f);
+}
+
+int main() {
+  brightestAtLargestGain();
+  samplerHoldsIntegrationTime();
+  medianOfEvenCount();
+  return Tests::finish("LightSensorTest");
+}
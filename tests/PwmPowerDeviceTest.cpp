@@ -0,0 +1,165 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "Check.h"
+#include "FakePico.h"
+
+#include "PwmPowerDevice.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace Device;
+
+constexpr unsigned int lamp_gpio = 10;
+constexpr int last_step = PwmPowerDevice::level_steps - 1;
+
+///
+/// \brief The CIE 1931 lightness, 0...100, of a duty cycle.
+///
+static double lightness(uint16_t level) {
+  double luminance = static_cast<double>(level) / PwmPowerDevice::pwm_wrap;
+  return luminance <= 0.008856 ? luminance * 903.3 : 116.0 * std::cbrt(luminance) - 16.0;
+}
+
+///
+/// \brief The lightness step, 0...255, of a duty cycle.
+///
+static int step(uint16_t level) {
+  return static_cast<int>(std::lround(lightness(level) * last_step / 100.0));
+}
+
+///
+/// \brief Whether a trace moves a step at a time, evenly spaced in time, from one step
+///   to another.
+///
+static bool isEvenFade(const std::vector<FakePico::PwmLevel>& trace, int from, int to,
+                       uint64_t intervalUs) {
+  int direction = to > from ? 1 : -1;
+  if (trace.size() != static_cast<size_t>((to - from) * direction)) {
+    return false;
+  }
+  for (size_t index = 0; index < trace.size(); ++index) {
+    auto& level = trace[index];
+    int expected = from + direction * static_cast<int>(index + 1);
+    if (level.gpio != lamp_gpio || step(level.level) != expected) {
+      return false;
+    }
+    if (index > 0 && level.timeUs - trace[index - 1].timeUs != intervalUs) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void fadeTraced() {
+  FakePico::clearPwmTrace();
+  PwmPowerDevice lamp(lamp_gpio);
+  lamp.init();
+  CHECK(FakePico::getPwmWrap(lamp_gpio) == PwmPowerDevice::pwm_wrap);
+  CHECK(FakePico::getPwmTrace().size() == 1 && FakePico::getPwmTrace()[0].level == 0);
+  
+  // A sunrise over a second takes every step, each a 255th of the second apart.
+  lamp.setTransitionDuration(1000);
+  FakePico::clearPwmTrace();
+  auto start = FakePico::nowUs();
+  lamp.setState(Core::PowerDevice::on);
+  CHECK(lamp.isFading());
+  FakePico::advanceMs(1000);
+  CHECK(!lamp.isFading());
+  CHECK(FakePico::getActiveTimerCount() == 0);
+  auto& trace = FakePico::getPwmTrace();
+  CHECK(isEvenFade(trace, 0, last_step, 1000000 / last_step));
+  CHECK(trace.front().timeUs - start == 1000000 / last_step);
+  CHECK(trace.back().timeUs - start <= 1000000);
+  CHECK(trace.back().level == PwmPowerDevice::pwm_wrap);
+  
+  // Each step raises the lightness by the same amount, where the duty cycle alone would
+  // rise slowly near black and quickly near full.
+  for (size_t index = 1; index < trace.size(); ++index) {
+    auto rise = lightness(trace[index].level) - lightness(trace[index - 1].level);
+    CHECK(std::fabs(rise - 100.0 / last_step) < 0.01);
+  }
+
+}
+
+static void reversedMidFade() {
+  FakePico::clearPwmTrace();
+  PwmPowerDevice lamp(lamp_gpio);
+  lamp.init();
+  lamp.setTransitionDuration(1000);
+  lamp.setState(Core::PowerDevice::on);
+  FakePico::advanceMs(400);
+  int reached = step(FakePico::getPwmTrace().back().level);
+  CHECK(reached == 102);
+  
+  // Switched off, it fades down from the step it reached over the whole duration.
+  FakePico::clearPwmTrace();
+  lamp.setState(Core::PowerDevice::off);
+  FakePico::advanceMs(1000);
+  CHECK(isEvenFade(FakePico::getPwmTrace(), reached, 0, 1000000 / reached));
+  CHECK(!lamp.isFading());
+  CHECK(FakePico::getActiveTimerCount() == 0);
+}
+
+static void timerRefusedSetsLevel() {
+  FakePico::clearPwmTrace();
+  PwmPowerDevice lamp(lamp_gpio);
+  lamp.init();
+  lamp.setTransitionDuration(1000);
+  
+  // With no alarm slot free, the lamp goes straight to the level.
+  FakePico::setTimerSlots(0);
+  FakePico::clearPwmTrace();
+  lamp.setPowerLevel(0.5f);
+  lamp.setState(Core::PowerDevice::on);
+  CHECK(!lamp.isFading());
+  CHECK(FakePico::getPwmTrace().size() == 1);
+  CHECK(step(FakePico::getPwmTrace().back().level) == 128);
+  
+  // A later fade starts from there.
+  FakePico::setTimerSlots(16);
+  FakePico::clearPwmTrace();
+  lamp.setState(Core::PowerDevice::off);
+  FakePico::advanceMs(1000);
+  CHECK(isEvenFade(FakePico::getPwmTrace(), 128, 0, 1000000 / 128));
+}
+
+int main() {
+  fadeTraced();
+  reversedMidFade();
+  timerRefusedSetsLevel();
+  return Tests::finish("PwmPowerDeviceTest");
+}
@@ -0,0 +1,246 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "Check.h"
+
+#include "Clock.h"
+#include "ControlConfiguration.h"
+#include "ScheduleCalendar.h"
+#include "SolarCalculator.h"
+
+#include <chrono>
+#include <cstdio>
+
+using namespace Core;
+
+// 2026-10-17, a Saturday, without its day of the week, as from epoch arithmetic.
+constexpr Date saturday = {0, 17, 10, 26};
+
+static bool isOn(const ControlConfiguration& configuration, Time time) {
+  return configuration.find(time).on;
+}
+
+static void dayOfWeekFromDate() {
+  ScheduleCalendar calendar;
+  ScheduleRule weekdays;
+  weekdays.daysOfWeek = ScheduleRule::weekdays;
+  weekdays.startTime = {0, 0, 8};
+  weekdays.endTime = {0, 0, 17};
+  calendar.addRule(weekdays);
+  
+  ControlConfiguration configuration;
+  calendar.compile(saturday, configuration);
+  CHECK(!isOn(configuration, {0, 0, 12}));
+  calendar.compile(Date{0, 19, 10, 26}, configuration);
+  CHECK(isOn(configuration, {0, 0, 12}));
+}
+
+static void wrappedWindowCarriedToNextDay() {
+  ScheduleCalendar calendar;
+  ScheduleRule nights;
+  nights.daysOfWeek = ScheduleRule::weekdays;
+  nights.startTime = {0, 0, 22};
+  nights.endTime = {0, 0, 6};
+  calendar.addRule(nights);
+  
+  // Friday night runs into Saturday morning.
+  ControlConfiguration configuration;
+  calendar.compile(Date{0, 16, 10, 26}, configuration);
+  CHECK(isOn(configuration, {0, 0, 3}));
+  CHECK(!isOn(configuration, {0, 0, 12}));
+  CHECK(isOn(configuration, {0, 0, 22}));
+  CHECK(configuration.find(Time{0, 0, 22}).end == Time::seconds_per_day);
+  
+  calendar.compile(saturday, configuration);
+  CHECK(isOn(configuration, {0, 0, 0}));
+  CHECK(configuration.find(Time{0, 0, 0}).end == Time{0, 0, 6}.inSeconds() + 1);
+  CHECK(!isOn(configuration, {0, 0, 22}));
+  
+  // Nothing carries from Sunday, or from Monday's own night, into Monday morning.
+  calendar.compile(Date{0, 19, 10, 26}, configuration);
+  CHECK(!isOn(configuration, {0, 0, 0}));
+  CHECK(!isOn(configuration, {0, 0, 3}));
+  CHECK(isOn(configuration, {0, 0, 22}));
+  
+  // An exception's window carries too, and the rules of the day it starts on do not.
+  ScheduleException late;
+  late.date = {0, 19, 10, 26};
+  late.startTime = {0, 0, 20};
+  late.endTime = {0, 0, 2};
+  calendar.addException(late);
+  calendar.compile(Date{0, 20, 10, 26}, configuration);
+  CHECK(isOn(configuration, {0, 0, 1}));
+  CHECK(!isOn(configuration, {0, 0, 3}));
+}
+
+static void anchorOffsetWrappedToNextDay() {
+  SolarCalculator solarCalculator(37.77f, -122.42f, -8 * 60);
+  ScheduleCalendar calendar;
+  calendar.setSolarCalculator(solarCalculator);
+  ScheduleRule evening;
+  evening.startAnchor = ScheduleRule::Anchor::sunset;
+  evening.endAnchor = ScheduleRule::Anchor::sunset;
+  evening.endOffsetMinutes = 8 * 60;
+  CHECK(calendar.addRule(evening));
+  
+  constexpr Date monday = {0, 19, 10, 26};
+  int32_t sunset = static_cast<int32_t>(solarCalculator.calculate(monday).sunset);
+  int32_t end = sunset + 8 * 60 * 60 - static_cast<int32_t>(Time::seconds_per_day);
+  CHECK(end > 0);
+  
+  ControlConfiguration configuration;
+  calendar.compile(monday, configuration);
+  CHECK(configuration.find(static_cast<uint32_t>(sunset)).on);
+  CHECK(configuration.find(Time{59, 59, 23}).end == Time::seconds_per_day);
+  
+  calendar.compile(Date{0, 20, 10, 26}, configuration);
+  auto span = configuration.find(Time{0, 0, 0});
+  CHECK(span.on);
+  CHECK(span.end == static_cast<uint32_t>(end) + 1);
+}
+
+static void anchorOffsetWrappedToDayBefore() {
+  SolarCalculator solarCalculator(37.77f, -122.42f, -8 * 60);
+  ScheduleCalendar calendar;
+  calendar.setSolarCalculator(solarCalculator);
+  ScheduleRule morning;
+  morning.startAnchor = ScheduleRule::Anchor::sunrise;
+  morning.startOffsetMinutes = -9 * 60;
+  morning.endAnchor = ScheduleRule::Anchor::sunrise;
+  CHECK(calendar.addRule(morning));
+  
+  constexpr Date tuesday = {0, 20, 10, 26};
+  int32_t sunrise = static_cast<int32_t>(solarCalculator.calculate(tuesday).sunrise);
+  int32_t start = sunrise - 9 * 60 * 60 + static_cast<int32_t>(Time::seconds_per_day);
+  CHECK(start < static_cast<int32_t>(Time::seconds_per_day));
+  
+  // Tuesday's window starts on Monday evening.
+  ControlConfiguration configuration;
+  calendar.compile(Date{0, 19, 10, 26}, configuration);
+  auto span = configuration.find(Time{59, 59, 23});
+  CHECK(span.on);
+  CHECK(span.start == static_cast<uint32_t>(start));
+  
+  ScheduleRule tooFar;
+  tooFar.startAnchor = ScheduleRule::Anchor::sunrise;
+  tooFar.startOffsetMinutes = ScheduleRule::maximum_offset_minutes + 1;
+  CHECK(!calendar.addRule(tooFar));
+}
+
+static void polarDayOnAllDay() {
+  // Tromsø, where the sun does not set from late May to late July.
+  SolarCalculator solarCalculator(69.65f, 18.96f, 60);
+  ScheduleCalendar calendar;
+  calendar.setSolarCalculator(solarCalculator);
+  ScheduleRule daylight;
+  daylight.startAnchor = ScheduleRule::Anchor::sunrise;
+  daylight.startOffsetMinutes = -30;
+  daylight.endAnchor = ScheduleRule::Anchor::sunset;
+  daylight.endOffsetMinutes = 30;
+  CHECK(calendar.addRule(daylight));
+  
+  Date midsummer = {0, 21, 6, 26};
+  CHECK(solarCalculator.calculate(midsummer).sunrise == 0);
+  CHECK(solarCalculator.calculate(midsummer).sunset == Time::seconds_per_day - 1);
+  ControlConfiguration configuration;
+  calendar.compile(midsummer, configuration);
+  auto span = configuration.find(Time{0, 0, 0});
+  CHECK(span.on && span.start == 0 && span.end == Time::seconds_per_day);
+  CHECK(isOn(configuration, {59, 59, 23}));
+}
+
+///
+/// \brief Compile each day of 2026 from a full calendar, in milliseconds.
+/// \description The rules and exceptions fill the calendar: a rule on each day of the
+///   week's mornings, seasonal and sun-anchored rules through the year, and exceptions
+///   spread over it.
+///
+static void fullYearInMilliseconds() {
+  SolarCalculator solarCalculator(37.77f, -122.42f, -8 * 60);
+  ScheduleCalendar calendar;
+  calendar.setSolarCalculator(solarCalculator);
+  for (size_t index = 0; index < ScheduleCalendar::maximum_rules; ++index) {
+    ScheduleRule rule;
+    auto month = static_cast<uint8_t>(index % 12 + 1);
+    rule.daysOfWeek = static_cast<uint8_t>(1 << index % 7);
+    rule.firstDay = {month, 1};
+    rule.lastDay = {static_cast<uint8_t>((month + 2) % 12 + 1), 28};
+    rule.startTime = {0, static_cast<uint8_t>(index), static_cast<uint8_t>(index % 12)};
+    rule.endTime = {0, static_cast<uint8_t>(index), static_cast<uint8_t>(index % 12 + 12)};
+    if (index % 4 == 1) {
+      rule.startAnchor = ScheduleRule::Anchor::sunrise;
+      rule.startOffsetMinutes = static_cast<int16_t>(-static_cast<int>(index));
+    }
+    if (index % 4 == 2) {
+      rule.endAnchor = ScheduleRule::Anchor::sunset;
+      rule.endOffsetMinutes = static_cast<int16_t>(index);
+    }
+    CHECK(calendar.addRule(rule));
+  }
+  for (size_t index = 0; index < ScheduleCalendar::maximum_exceptions; ++index) {
+    ScheduleException exception;
+    exception.date = Date::fromDays(Date{0, 1, 1, 26}.toDays() + 11 * index);
+    exception.off = index % 2 == 0;
+    exception.startTime = {0, 0, 9};
+    exception.endTime = {0, 0, 13};
+    CHECK(calendar.addException(exception));
+  }
+  
+  ControlConfiguration configuration;
+  uint32_t windowCount = 0;
+  auto first = Date{0, 1, 1, 26}.toDays();
+  auto start = std::chrono::steady_clock::now();
+  for (uint32_t day = first; day < first + 365; ++day) {
+    calendar.compile(Date::fromDays(day), configuration);
+    windowCount += configuration.getWindowCount();
+  }
+  auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+  std::printf("365 days of %lu rules and %lu exceptions: %lu windows, %.2f ms\n",
+              static_cast<unsigned long>(ScheduleCalendar::maximum_rules),
+              static_cast<unsigned long>(ScheduleCalendar::maximum_exceptions),
+              static_cast<unsigned long>(windowCount), elapsed.count() * 1000.0);
+  // About a window a day, as the rules on a day mostly overlap and merge.
+  CHECK(windowCount > 300);
+  CHECK(elapsed.count() < 0.05);
+}
+
+int main() {
+  dayOfWeekFromDate();
+  wrappedWindowCarriedToNextDay();
+  anchorOffsetWrappedToNextDay();
+  anchorOffsetWrappedToDayBefore();
+  polarDayOnAllDay();
+  fullYearInMilliseconds();
+  return Tests::finish("ScheduleCalendarTest");
+}
@@ -0,0 +1,133 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+// Lists the transitions of a stored configuration over a range of dates, so a schedule
+// change can be checked before it is sent to a controller:
+//
+//   ScheduleReport 2026-10-19 2027-01-01 [configuration.bin]
+//
+// The configuration is the bytes of a Core::StoredConfiguration, as written by
+// `power_control.py PORT configuration read FILE`. Without one, the power controller's
+// default is used, on from half an hour before sunrise to half an hour after sunset.
+
+#include "ClockFormat.h"
+#include "ConfigurationStore.h"
+#include "ControlConfiguration.h"
+#include "RecordingPowerDevice.h"
+#include "ScheduleCalendar.h"
+#include "ScheduleSimulator.h"
+#include "SolarCalculator.h"
+#include "TimeScheduler.h"
+#include "VirtualClockDevice.h"
+
+#include <chrono>
+#include <cstdio>
+
+using namespace Core;
+
+constexpr ClockFormat transition_format{"%Y-%m-%d %a %H:%M:%S"};
+
+static bool parseDate(const char* text, Date& date) {
+  unsigned int year, month, day;
+  if (std::sscanf(text, "%4u-%2u-%2u", &year, &month, &day) != 3 || year < 2000) {
+    return false;
+  }
+  date = {0, static_cast<uint8_t>(day), static_cast<uint8_t>(month), 
+          static_cast<uint8_t>(year - 2000)};
+  return date.isValid();
+}
+
+static bool readConfiguration(const char* path, StoredConfiguration& configuration) {
+  auto file = std::fopen(path, "rb");
+  if (file == nullptr) {
+    return false;
+  }
+  bool complete = std::fread(&configuration, sizeof(configuration), 1, file) == 1;
+  std::fclose(file);
+  return complete && configuration.isValid();
+}
+
+// Kept out of the stack.
+static StoredConfiguration storedConfiguration;
+
+int main(int argc, char* argv[]) {
+  Date first, last;
+  if (argc < 3 || argc > 4 || !parseDate(argv[1], first) || !parseDate(argv[2], last)) {
+    std::fprintf(stderr, "usage: %s FIRST-DATE END-DATE [CONFIGURATION]\n"
+                 "  dates as YYYY-MM-DD from 2000 to 2099, the end not included\n", argv[0]);
+    return 2;
+  }
+  if (argc == 4) {
+    if (!readConfiguration(argv[3], storedConfiguration)) {
+      std::fprintf(stderr, "%s is not a valid stored configuration\n", argv[3]);
+      return 1;
+    }
+  } else {
+    storedConfiguration.latitude = 37.77f;
+    storedConfiguration.longitude = -122.42f;
+    storedConfiguration.utcOffsetMinutes = -8 * 60;
+    ScheduleRule daylight;
+    daylight.startAnchor = ScheduleRule::Anchor::sunrise;
+    daylight.startOffsetMinutes = -30;
+    daylight.endAnchor = ScheduleRule::Anchor::sunset;
+    daylight.endOffsetMinutes = 30;
+    storedConfiguration.addRule(daylight);
+  }
+  
+  VirtualClockDevice clockDevice;
+  RecordingPowerDevice powerDevice;
+  ControlConfiguration configuration;
+  ScheduleCalendar calendar;
+  SolarCalculator solarCalculator(storedConfiguration.latitude, storedConfiguration.longitude,
+                                  storedConfiguration.utcOffsetMinutes);
+  calendar.setSolarCalculator(solarCalculator);
+  storedConfiguration.apply(configuration, calendar);
+  TimeScheduler scheduler(powerDevice, clockDevice, configuration);
+  scheduler.setCalendar(calendar);
+  ScheduleSimulator simulator(scheduler, clockDevice, powerDevice);
+  
+  uint32_t transitionCount = 0;
+  auto start = std::chrono::steady_clock::now();
+  auto updateCount = simulator.run({{0, 0, 0}, first}, {{0, 0, 0}, last},
+    [&](const ScheduleTransition& transition) {
+      std::printf("%s %s\n", formatClock<transition_format>(transition.clockDatum).c_str(),
+                  transition.state == PowerDevice::on ? "on" : "off");
+      ++transitionCount;
+    });
+  auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+  std::fprintf(stderr, "%lu transitions, %lu updates, %.1f ms\n", 
+               static_cast<unsigned long>(transitionCount), 
+               static_cast<unsigned long>(updateCount), elapsed.count() * 1000.0);
+  return 0;
+}
@@ -0,0 +1,169 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "Check.h"
+
+#include "ControlConfiguration.h"
+#include "PowerDevice.h"
+#include "RecordingPowerDevice.h"
+#include "ScheduleCalendar.h"
+#include "ScheduleSimulator.h"
+#include "SolarCalculator.h"
+#include "TimeScheduler.h"
+#include "VirtualClockDevice.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using namespace Core;
+
+///
+/// \brief Weekdays on through the working day, weekends from before sunrise to after 
+///   sunset, a night shift past midnight on Fridays, and Christmas Day off.
+///
+static void addRules(ScheduleCalendar& calendar) {
+  ScheduleRule workday;
+  workday.daysOfWeek = ScheduleRule::weekdays;
+  workday.startTime = {0, 0, 7};
+  workday.endTime = {0, 0, 19};
+  calendar.addRule(workday);
+  
+  ScheduleRule weekend;
+  weekend.daysOfWeek = ScheduleRule::weekends;
+  weekend.startAnchor = ScheduleRule::Anchor::sunrise;
+  weekend.startOffsetMinutes = -30;
+  weekend.endAnchor = ScheduleRule::Anchor::sunset;
+  weekend.endOffsetMinutes = 30;
+  calendar.addRule(weekend);
+  
+  ScheduleRule nightShift;
+  nightShift.daysOfWeek = ScheduleRule::friday;
+  nightShift.startTime = {0, 0, 22};
+  nightShift.endTime = {0, 0, 3};
+  calendar.addRule(nightShift);
+  
+  calendar.addException({{0, 25, 12, 26}, true, {0, 0, 0}, {0, 0, 0}});
+}
+
+///
+/// \brief A scheduler over a calendar, as a ScheduleSimulator runs it.
+///
+struct Bench {
+  VirtualClockDevice clockDevice;
+  RecordingPowerDevice powerDevice;
+  ControlConfiguration configuration;
+  ScheduleCalendar calendar;
+  SolarCalculator solarCalculator{37.77f, -122.42f, -8 * 60};
+  TimeScheduler scheduler{powerDevice, clockDevice, configuration};
+  
+  Bench() {
+    calendar.setSolarCalculator(solarCalculator);
+    addRules(calendar);
+    scheduler.setCalendar(calendar);
+  }
+};
+
+static bool isSame(const ScheduleTransition& a, const ScheduleTransition& b) {
+  return a.clockDatum.time == b.clockDatum.time && a.clockDatum.date == b.clockDatum.date &&
+    a.state == b.state;
+}
+
+static void yearWellUnderSecond() {
+  Bench bench;
+  ScheduleSimulator simulator(bench.scheduler, bench.clockDevice, bench.powerDevice);
+  
+  uint32_t transitionCount = 0;
+  uint32_t christmasOnCount = 0;
+  auto start = std::chrono::steady_clock::now();
+  auto updateCount = simulator.run({{0, 0, 0}, {0, 1, 1, 26}}, {{0, 0, 0}, {0, 1, 1, 27}},
+    [&](const ScheduleTransition& transition) {
+      ++transitionCount;
+      if (transition.clockDatum.date == Date{0, 25, 12, 26} && 
+        transition.state == PowerDevice::on)
+      {
+        ++christmasOnCount;
+      }
+    });
+  auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start);
+  std::printf("365 days: %lu transitions, %lu updates, %.1f ms\n", 
+              static_cast<unsigned long>(transitionCount), 
+              static_cast<unsigned long>(updateCount), elapsed.count() * 1000.0);
+  
+  // Each day is on and off once, and Fridays' night shift a second time, about 834, with 
+  // Christmas off throughout.
+  CHECK(transitionCount > 800 && transitionCount < 860);
+  CHECK(christmasOnCount == 0);
+  CHECK(updateCount < 6 * 366);
+  CHECK(elapsed.count() < 0.25);
+}
+
+static void matchesSecondBySecond() {
+  // Two weeks across the change of month, stepped a second at a time and simulated.
+  ClockDatum start = {{0, 0, 0}, {0, 20, 2, 26}};
+  ClockDatum end = {{0, 0, 0}, {0, 6, 3, 26}};
+  
+  Bench stepped;
+  std::vector<ScheduleTransition> expected;
+  stepped.clockDevice.write(start);
+  auto changeCount = stepped.powerDevice.getChangeCount();
+  for (auto seconds = EpochSeconds::fromClockDatum(start); 
+       seconds < EpochSeconds::fromClockDatum(end); seconds = seconds + 1) 
+  {
+    stepped.scheduler.update();
+    if (expected.empty() || stepped.powerDevice.getChangeCount() != changeCount) {
+      expected.push_back({stepped.clockDevice.read(), stepped.powerDevice.getStatus()});
+      changeCount = stepped.powerDevice.getChangeCount();
+    }
+    stepped.clockDevice.advance(1);
+  }
+  
+  Bench simulated;
+  ScheduleSimulator simulator(simulated.scheduler, simulated.clockDevice, simulated.powerDevice);
+  std::vector<ScheduleTransition> transitions;
+  simulator.run(start, end, [&](const ScheduleTransition& transition) {
+    transitions.push_back(transition);
+  });
+  
+  CHECK(transitions.size() == expected.size());
+  CHECK(std::equal(transitions.begin(), transitions.end(), expected.begin(), expected.end(),
+                   isSame));
+}
+
+int main() {
+  yearWellUnderSecond();
+  matchesSecondBySecond();
+  return Tests::finish("ScheduleSimulatorTest");
+}
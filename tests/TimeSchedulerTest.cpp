@@ -0,0 +1,197 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+#include "Check.h"
+
+#include "ControlConfiguration.h"
+#include "PowerDevice.h"
+#include "RecordingPowerDevice.h"
+#include "ScheduleCalendar.h"
+#include "TimeScheduler.h"
+#include "VirtualClockDevice.h"
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace Core;
+
+// 2026-10-19, a Monday.
+constexpr Date monday = {2, 19, 10, 26};
+
+static void overrideHeldWithinSecond() {
+  VirtualClockDevice clockDevice;
+  RecordingPowerDevice powerDevice;
+  ControlConfiguration configuration;
+  configuration.addWindow({0, 0, 8}, {0, 0, 17});
+  TimeScheduler scheduler(powerDevice, clockDevice, configuration);
+  
+  clockDevice.write({{0, 0, 12}, monday});
+  scheduler.update();
+  CHECK(powerDevice.getStatus() == PowerDevice::on);
+  
+  // As the controller does after a request, in the same second as the last update.
+  scheduler.setOverride(false);
+  scheduler.update();
+  scheduler.update();
+  CHECK(scheduler.isOverridden());
+  CHECK(powerDevice.getStatus() == PowerDevice::off);
+  
+  clockDevice.advance(60);
+  scheduler.update();
+  CHECK(scheduler.isOverridden());
+  CHECK(powerDevice.getStatus() == PowerDevice::off);
+  
+  // The schedule takes over at the next transition.
+  clockDevice.write({{0, 0, 17}, monday});
+  clockDevice.advance(1);
+  scheduler.update();
+  CHECK(!scheduler.isOverridden());
+  CHECK(powerDevice.getStatus() == PowerDevice::off);
+}
+
+static void overrideHeldWithinSecondWithCalendar() {
+  VirtualClockDevice clockDevice;
+  RecordingPowerDevice powerDevice;
+  ControlConfiguration configuration;
+  ScheduleCalendar calendar;
+  ScheduleRule rule;
+  rule.startTime = {0, 0, 8};
+  rule.endTime = {0, 0, 17};
+  calendar.addRule(rule);
+  TimeScheduler scheduler(powerDevice, clockDevice, configuration);
+  scheduler.setCalendar(calendar);
+  
+  clockDevice.write({{0, 0, 12}, monday});
+  scheduler.update();
+  scheduler.setOverride(false);
+  scheduler.update();
+  scheduler.update();
+  CHECK(scheduler.isOverridden());
+  CHECK(powerDevice.getStatus() == PowerDevice::off);
+}
+
+static void wholeDaySleptThrough() {
+  VirtualClockDevice clockDevice;
+  RecordingPowerDevice powerDevice;
+  ControlConfiguration configuration;
+  ScheduleCalendar calendar;
+  ScheduleRule allDay;
+  allDay.startTime = {0, 0, 0};
+  allDay.endTime = {59, 59, 23};
+  calendar.addRule(allDay);
+  ScheduleException holiday;
+  holiday.date = monday;
+  holiday.off = true;
+  calendar.addException(holiday);
+  TimeScheduler scheduler(powerDevice, clockDevice, configuration);
+  scheduler.setCalendar(calendar);
+  
+  // Off all of the holiday, and on all of the next day.
+  clockDevice.write({{0, 0, 0}, monday});
+  scheduler.update();
+  CHECK(powerDevice.getStatus() == PowerDevice::off);
+  CHECK(scheduler.getSecondsToNextTransition() == Time::seconds_per_day);
+  
+  clockDevice.advance(scheduler.getSecondsToNextTransition());
+  scheduler.update();
+  CHECK(powerDevice.getStatus() == PowerDevice::on);
+}
+
+///
+/// \brief A virtual clock that counts its reads, each a bus transaction on the DS3231.
+///
+class CountingClockDevice final : public RealTimeClockDevice {
+public:
+  VirtualClockDevice clockDevice;
+  uint32_t readCount = 0;
+  
+  Time readTime() override { ++readCount; return clockDevice.readTime(); }
+  Date readDate() override { ++readCount; return clockDevice.readDate(); }
+  ClockDatum read() override { ++readCount; return clockDevice.read(); }
+  void write(ClockDatum clockDatum) override { clockDevice.write(clockDatum); }
+}; // class CountingClockDevice
+
+///
+/// \brief Run the power controller's loop over 2026, sleeping until each next transition
+///   but at most maximumSleepSeconds, and report its wake-ups and clock reads against
+///   polling the clock each second.
+///
+static void yearOfWakeUps(const char* name, uint32_t maximumSleepSeconds) {
+  CountingClockDevice clockDevice;
+  RecordingPowerDevice powerDevice;
+  ControlConfiguration configuration;
+  ScheduleCalendar calendar;
+  ScheduleRule workday;
+  workday.daysOfWeek = ScheduleRule::weekdays;
+  workday.startTime = {0, 0, 7};
+  workday.endTime = {0, 0, 19};
+  calendar.addRule(workday);
+  TimeScheduler scheduler(powerDevice, clockDevice, configuration);
+  scheduler.setCalendar(calendar);
+  
+  constexpr uint32_t days = 365;
+  constexpr uint32_t year_seconds = days * Time::seconds_per_day;
+  clockDevice.write({{0, 0, 0}, {4, 1, 1, 26}});
+  uint32_t wakeCount = 0;
+  for (uint32_t second = 0; second < year_seconds; ) {
+    scheduler.update();
+    ++wakeCount;
+    auto sleepSeconds = std::min(scheduler.getSecondsToNextTransition(), maximumSleepSeconds);
+    clockDevice.clockDevice.advance(sleepSeconds);
+    second += sleepSeconds;
+  }
+  
+  // Polling woke and read the time each second.
+  std::printf("%s: %lu wake-ups and %lu clock reads in a year, against %lu polling\n", name,
+              static_cast<unsigned long>(wakeCount), 
+              static_cast<unsigned long>(clockDevice.readCount), 
+              static_cast<unsigned long>(year_seconds));
+  
+  // Two transitions each of the 261 weekdays. A day takes a wake-up for each longest sleep
+  // in it, and at most three more, at midnight and the two transitions.
+  CHECK(powerDevice.getChangeCount() == 2 * 261);
+  CHECK(wakeCount <= days * (Time::seconds_per_day / maximumSleepSeconds + 3));
+  CHECK(clockDevice.readCount <= 3 * wakeCount);
+  CHECK(clockDevice.readCount * 1000 < year_seconds);
+}
+
+int main() {
+  overrideHeldWithinSecond();
+  overrideHeldWithinSecondWithCalendar();
+  wholeDaySleptThrough();
+  // The timer loop's sleeps are capped at an hour, and dormant sleeps last to the alarm.
+  yearOfWakeUps("Timer", 60 * 60);
+  yearOfWakeUps("Dormant", Time::seconds_per_day);
+  return Tests::finish("TimeSchedulerTest");
+}
@@ -0,0 +1,72 @@
+// BSD 3-Clause License
+//
+// Copyright (c) 2024, Brian Keith Smith
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// 3. Neither the name of the copyright holder nor the names of its
+//    contributors may be used to endorse or promote products derived from
+//    this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+//
+//
+// Created by Brian Smith 10/19/2026
+//
+
+// Host stand-in for the Pico SDK's pico/time.h, over the simulated clock of FakePico.h.
+
+#pragma once
+
+#include <cstdint>
+
+typedef uint64_t absolute_time_t;
+
+absolute_time_t get_absolute_time();
+uint64_t to_us_since_boot(absolute_time_t time);
+uint32_t to_ms_since_boot(absolute_time_t time);
+absolute_time_t delayed_by_us(absolute_time_t time, uint64_t us);
+absolute_time_t delayed_by_ms(absolute_time_t time, uint32_t ms);
+absolute_time_t make_timeout_time_us(uint64_t us);
+absolute_time_t make_timeout_time_ms(uint32_t ms);
+int64_t absolute_time_diff_us(absolute_time_t from, absolute_time_t to);
+bool time_reached(absolute_time_t time);
+
+void sleep_until(absolute_time_t time);
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+bool best_effort_wfe_or_timeout(absolute_time_t time);
+
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t* timer);
+
+struct repeating_timer {
+  int64_t delay_us;
+  absolute_time_t next_time;
+  repeating_timer_callback_t callback;
+  void* user_data;
+};
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, 
+                            void* user_data, repeating_timer_t* timer);
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback,
+                            void* user_data, repeating_timer_t* timer);
+bool cancel_repeating_timer(repeating_timer_t* timer);